@@ -2,6 +2,36 @@
 
 #include "Movement.h"
 #include "Modules/ModuleManager.h"
+#include "LedgeData.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, Movement, "Movement" );
- 
\ No newline at end of file
+DEFINE_STAT(STAT_ClimbingTick);
+DEFINE_STAT(STAT_ClimbReachProbes);
+DEFINE_STAT(STAT_ClimbReachRejects);
+DEFINE_STAT(STAT_ClimbForwardProbes);
+DEFINE_STAT(STAT_ClimbForwardRejects);
+DEFINE_STAT(STAT_ClimbHeightProbes);
+DEFINE_STAT(STAT_ClimbHeightRejects);
+DEFINE_STAT(STAT_ClimbHopCandidates);
+DEFINE_STAT(STAT_ClimbSceneQueries);
+DEFINE_STAT(STAT_ClimbValidateGrab);
+DEFINE_STAT(STAT_ClimbValidateShimmy);
+DEFINE_STAT(STAT_ClimbValidationRequests);
+DEFINE_STAT(STAT_ClimbValidationRejects);
+DEFINE_STAT(STAT_ClimbValidationCorrections);
+DEFINE_STAT(STAT_LedgeDataMappedMemory);
+
+class FMovementModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+		FLedgeDataRegistry::Get().Startup();
+	}
+
+	virtual void ShutdownModule() override
+	{
+		FLedgeDataRegistry::Get().Shutdown();
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FMovementModule, Movement, "Movement" );
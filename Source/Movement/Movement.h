@@ -3,3 +3,28 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("Climbing"), STATGROUP_Climbing, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Climbing Tick"), STAT_ClimbingTick, STATGROUP_Climbing, );
+
+// Ledge probe pipeline: how many times each stage ran and how many times it rejected
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Reach Probes"), STAT_ClimbReachProbes, STATGROUP_Climbing, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Reach Rejects"), STAT_ClimbReachRejects, STATGROUP_Climbing, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Forward Probes"), STAT_ClimbForwardProbes, STATGROUP_Climbing, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Forward Rejects"), STAT_ClimbForwardRejects, STATGROUP_Climbing, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Height Probes"), STAT_ClimbHeightProbes, STATGROUP_Climbing, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Height Rejects"), STAT_ClimbHeightRejects, STATGROUP_Climbing, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Hop Candidates"), STAT_ClimbHopCandidates, STATGROUP_Climbing, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Scene Queries"), STAT_ClimbSceneQueries, STATGROUP_Climbing, );
+
+// Server side validation of client grab and shimmy requests
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Validate Grab"), STAT_ClimbValidateGrab, STATGROUP_Climbing, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Validate Shimmy"), STAT_ClimbValidateShimmy, STATGROUP_Climbing, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Validation Requests"), STAT_ClimbValidationRequests, STATGROUP_Climbing, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Validation Rejects"), STAT_ClimbValidationRejects, STATGROUP_Climbing, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Validation Corrections"), STAT_ClimbValidationCorrections, STATGROUP_Climbing, );
+
+// Address space mapped for baked ledge data, pages only become resident as queries touch them
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Ledge Data Mapped"), STAT_LedgeDataMappedMemory, STATGROUP_Climbing, );
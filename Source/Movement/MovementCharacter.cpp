@@ -5,14 +5,11 @@
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/InputComponent.h"
-#include "Components/ArrowComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/Controller.h"
 #include "GameFramework/SpringArmComponent.h"
-#include "Kismet/KismetSystemLibrary.h"
-#include "Kismet/KismetMathLibrary.h"
-#include "WorldCollision.h"
-#include "LedgeClimbInterface.h"
+#include "Net/UnrealNetwork.h"
+#include "ClimbingComponent.h"
 
 //////////////////////////////////////////////////////////////////////////
 // AMovementCharacter
@@ -49,47 +46,16 @@ AMovementCharacter::AMovementCharacter()
 	FollowCamera->SetupAttachment(CameraBoom, USpringArmComponent::SocketName); // Attach the camera to the end of the boom and let the boom adjust to match the controller orientation
 	FollowCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
 
-	ClimbArrowRadius = 10.0f;
-
-	LeftClimbArrow = CreateDefaultSubobject<UArrowComponent>(TEXT("LeftClimbArrow"));
-	LeftClimbArrow->SetupAttachment(RootComponent);
-	LeftClimbArrow->SetRelativeLocation(FVector(0.0f, -(GetCapsuleComponent()->GetScaledCapsuleRadius() / 2.0f - ClimbArrowRadius), 0.0f));
-
-	RightClimbArrow = CreateDefaultSubobject<UArrowComponent>(TEXT("RightClimbArrow"));
-	RightClimbArrow->SetupAttachment(RootComponent);
-	RightClimbArrow->SetRelativeLocation(FVector(0.0f, GetCapsuleComponent()->GetScaledCapsuleRadius() / 2.0f - ClimbArrowRadius, 0.0f));
-
-	LeftClimbArrow2 = CreateDefaultSubobject<UArrowComponent>(TEXT("LeftClimbArrow2"));
-	LeftClimbArrow2->SetupAttachment(RootComponent);
-	LeftClimbArrow2->SetRelativeLocation(FVector(0.0f, -(GetCapsuleComponent()->GetScaledCapsuleRadius() / 2.0f + ClimbArrowRadius), 0.0f));
-
-	RightClimbArrow2 = CreateDefaultSubobject<UArrowComponent>(TEXT("RightClimbArrow2"));
-	RightClimbArrow2->SetupAttachment(RootComponent);
-	RightClimbArrow2->SetRelativeLocation(FVector(0.0f, GetCapsuleComponent()->GetScaledCapsuleRadius() / 2.0f + ClimbArrowRadius, 0.0f));
-
-
-	bIsLedgeClimbing = false;
-	bIsHanging = false;
-
-	LeftArrow = CreateDefaultSubobject<UArrowComponent>(TEXT("LeftArrow"));
-	LeftArrow->SetupAttachment(RootComponent);
-	LeftArrow->SetRelativeLocation(FVector(40.0f, -60.0f, 40.0f));
-
-	RightArrow = CreateDefaultSubobject<UArrowComponent>(TEXT("RightArrow"));
-	RightArrow->SetupAttachment(RootComponent);
-	RightArrow->SetRelativeLocation(FVector(40.0f, 60.0f, 40.0f));
-
-	
+	bCanClimb = false;
+	ClimbingComponentClass = UClimbingComponent::StaticClass();
 	bCanLedgeMoveRight = false;
 	bCanLedgeMoveLeft = false;
-
-	LeftLedgeJumpArrow = CreateDefaultSubobject<UArrowComponent>(TEXT("LeftLedgeArrow"));
-	LeftLedgeJumpArrow->SetupAttachment(RootComponent);
-	LeftLedgeJumpArrow->SetRelativeLocation(FVector(50, -150, 40));
-
-	RightLedgeJumpArrow = CreateDefaultSubobject<UArrowComponent>(TEXT("RightLedgeArrow"));
-	RightLedgeJumpArrow->SetupAttachment(RootComponent);
-	RightLedgeJumpArrow->SetRelativeLocation(FVector(50, 150, 40));
+	bMovingLedgeRight = false;
+	bMovingLedgeLeft = false;
+	bReplicatedHanging = false;
+	bReplicatedLedgeClimbing = false;
+	bReplicatedMovingLedgeRight = false;
+	bReplicatedMovingLedgeLeft = false;
 
 	// Note: The skeletal mesh and anim blueprint references on the Mesh component (inherited from Character) 
 	// are set in the derived blueprint asset named MyCharacter (to avoid direct content references in C++)
@@ -133,383 +99,150 @@ void AMovementCharacter::LookUpAtRate(float Rate)
 	AddControllerPitchInput(Rate * BaseLookUpRate * GetWorld()->GetDeltaSeconds());
 }
 
-void AMovementCharacter::RightForwardTracer()
+void AMovementCharacter::BeginPlay()
 {
-	FVector StartTrace = RightClimbArrow->GetComponentLocation();
-	FVector StartTrace2 = RightClimbArrow2->GetComponentLocation();
-	FVector EndTrace = GetActorRotation().Vector();
-	EndTrace.X *= 150.0f;
-	EndTrace.Y *= 150.0f;
-	FVector EndTrace2 = EndTrace + StartTrace2;
-	EndTrace += StartTrace;
-	TArray<AActor*> ActorsToIgnore;
-
-	FHitResult Hit;
-	FHitResult Hit2;
-
-	if (UKismetSystemLibrary::SphereTraceSingle(GetWorld(), StartTrace, EndTrace, ClimbArrowRadius, ETraceTypeQuery::TraceTypeQuery3,
-		false, ActorsToIgnore, EDrawDebugTrace::ForOneFrame, Hit, true) &&
-		UKismetSystemLibrary::SphereTraceSingle(GetWorld(), StartTrace2, EndTrace2, ClimbArrowRadius, ETraceTypeQuery::TraceTypeQuery3,
-			false, ActorsToIgnore, EDrawDebugTrace::ForOneFrame, Hit2, true))
-	{
-		if (Hit.Normal.Equals(Hit2.Normal))
-		{
-			RightWallLocation = Hit.ImpactPoint;
-			RightWallNormal = Hit.Normal;
-			//UE_LOG(LogTemp, Warning, TEXT("ImpactPoint: %s, Normal: %s"), *RightWallLocation.ToString(), *RightWallNormal.ToString());
-			bRightSuccessfulForwardTrace = true;
-		}
-		else
-		{
-			bRightSuccessfulForwardTrace = false;
-		}
-	}
-	else
+	Super::BeginPlay();
+	if (bCanClimb)
 	{
-		bRightSuccessfulForwardTrace = false;
+		EnableClimbing();
 	}
-	
 }
 
-void AMovementCharacter::RightHeightTracer()
+void AMovementCharacter::PossessedBy(AController* NewController)
 {
-	FVector StartTrace = RightClimbArrow->GetComponentLocation();
-	FVector StartTrace2 = RightClimbArrow2->GetComponentLocation();
-	StartTrace.Z += 500.0f;
-	StartTrace2.Z += 500.0f;
-	FVector ForwardDirection = GetActorRotation().Vector() * 70.0f;
-
-	StartTrace += ForwardDirection;
-	StartTrace2 += ForwardDirection;
-
-	FVector EndTrace = RightClimbArrow->GetComponentLocation() + ForwardDirection;
-	FVector EndTrace2 = RightClimbArrow2->GetComponentLocation() + ForwardDirection;
-	
-	TArray<AActor*> ActorsToIgnore;
-
-	FHitResult Hit;
-	FHitResult Hit2;
-
-	if (UKismetSystemLibrary::SphereTraceSingle(GetWorld(), StartTrace, EndTrace, ClimbArrowRadius, ETraceTypeQuery::TraceTypeQuery3,
-		false, ActorsToIgnore, EDrawDebugTrace::ForOneFrame, Hit, true) &&
-		UKismetSystemLibrary::SphereTraceSingle(GetWorld(), StartTrace2, EndTrace2, ClimbArrowRadius, ETraceTypeQuery::TraceTypeQuery3,
-			false, ActorsToIgnore, EDrawDebugTrace::ForOneFrame, Hit2, true) &&
-		bRightSuccessfulForwardTrace)
+	Super::PossessedBy(NewController);
+	if (NewController && NewController->IsPlayerController())
 	{
-		RightHeightLocation = Hit.ImpactPoint;
-		float PelvisDuringImpact = GetMesh()->GetSocketLocation("PelvisSocket").Z - RightHeightLocation.Z;
-		float MinHeight = -50.0f;
-		float MaxHeight = 0.0f;
-		//UE_LOG(LogTemp, Warning, TEXT("Check Climb %.2f"), PelvisDuringImpact);
-		if (MinHeight < PelvisDuringImpact && PelvisDuringImpact < MaxHeight)
-		{
-			if (!bIsLedgeClimbing)
-			{
-				
-				//UE_LOG(LogTemp, Warning, TEXT("Right Climb"));
-				GrabLedge(RightHeightLocation, RightWallLocation, RightWallNormal);
-			}
-		}
+		EnableClimbing();
 	}
+}
 
+void AMovementCharacter::PawnClientRestart()
+{
+	// Possession only runs on the server, the owning client probes too so it needs the component as well
+	Super::PawnClientRestart();
+	EnableClimbing();
 }
 
-void AMovementCharacter::LeftForwardTracer()
+void AMovementCharacter::EnableClimbing()
 {
-	FVector StartTrace = LeftClimbArrow->GetComponentLocation();
-	FVector StartTrace2 = LeftClimbArrow2->GetComponentLocation();
-	FVector EndTrace = GetActorRotation().Vector();
-	EndTrace.X *= 150.0f;
-	EndTrace.Y *= 150.0f;
-	FVector EndTrace2 = EndTrace + StartTrace2;
-	EndTrace += StartTrace;
-	TArray<AActor*> ActorsToIgnore;
-
-	FHitResult Hit;
-	FHitResult Hit2;
-
-	if (UKismetSystemLibrary::SphereTraceSingle(GetWorld(), StartTrace, EndTrace, ClimbArrowRadius, ETraceTypeQuery::TraceTypeQuery3,
-		false, ActorsToIgnore, EDrawDebugTrace::ForOneFrame, Hit, true) &&
-		UKismetSystemLibrary::SphereTraceSingle(GetWorld(), StartTrace2, EndTrace2, ClimbArrowRadius, ETraceTypeQuery::TraceTypeQuery3,
-			false, ActorsToIgnore, EDrawDebugTrace::ForOneFrame, Hit2, true))
+	if (!Climbing)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("ImpactPoint: %s, Normal: %s"), *Hit.Normal.ToString(), *Hit2.Normal.ToString());
-		if (Hit.Normal.Equals(Hit2.Normal))
-		{
-			LeftWallLocation = Hit.ImpactPoint;
-			LeftWallNormal = Hit.Normal;
-			bLeftSuccessfulForwardTrace = true;
-			UE_LOG(LogTemp, Warning, TEXT("Assign"));
-		}
-		else
-		{
-			bLeftSuccessfulForwardTrace = false;
-		}
+		UClass* ComponentClass = ClimbingComponentClass ? *ClimbingComponentClass : UClimbingComponent::StaticClass();
+		Climbing = NewObject<UClimbingComponent>(this, ComponentClass, TEXT("Climbing"));
+		Climbing->RegisterComponent();
 	}
-	else
-	{
-		bLeftSuccessfulForwardTrace = false;
-	}
-
 }
 
-void AMovementCharacter::LeftHeightTracer()
+void AMovementCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
-	FVector StartTrace = LeftClimbArrow->GetComponentLocation();
-	FVector StartTrace2 = LeftClimbArrow2->GetComponentLocation();
-	StartTrace.Z += 500.0f;
-	StartTrace2.Z += 500.0f;
-	FVector ForwardDirection = GetActorRotation().Vector() * 70.0f;
-
-	StartTrace += ForwardDirection;
-	StartTrace2 += ForwardDirection;
-
-	FVector EndTrace = LeftClimbArrow->GetComponentLocation() + ForwardDirection;
-	FVector EndTrace2 = LeftClimbArrow2->GetComponentLocation() + ForwardDirection;
-
-	TArray<AActor*> ActorsToIgnore;
-
-	FHitResult Hit;
-	FHitResult Hit2;
-
-	if (UKismetSystemLibrary::SphereTraceSingle(GetWorld(), StartTrace, EndTrace, ClimbArrowRadius, ETraceTypeQuery::TraceTypeQuery3,
-		false, ActorsToIgnore, EDrawDebugTrace::ForOneFrame, Hit, true) &&
-		UKismetSystemLibrary::SphereTraceSingle(GetWorld(), StartTrace2, EndTrace2, ClimbArrowRadius, ETraceTypeQuery::TraceTypeQuery3,
-			false, ActorsToIgnore, EDrawDebugTrace::ForOneFrame, Hit2, true) &&
-		bLeftSuccessfulForwardTrace)
-	{
-		LeftHeightLocation = Hit.ImpactPoint;
-		float PelvisDuringImpact = GetMesh()->GetSocketLocation("PelvisSocket").Z - LeftHeightLocation.Z;
-		float MinHeight = -50.0f;
-		float MaxHeight = 0.0f;
-		//UE_LOG(LogTemp, Warning, TEXT("Check Climb %.2f"), PelvisDuringImpact);
-		if (MinHeight < PelvisDuringImpact && PelvisDuringImpact < MaxHeight)
-		{
-			if (!bIsLedgeClimbing)
-			{
-
-				//UE_LOG(LogTemp, Warning, TEXT("Left Climb"));
-				GrabLedge(LeftHeightLocation, LeftWallLocation, LeftWallNormal);
-			}
-		}
-	}
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
+	// The owning client probes for itself
+	DOREPLIFETIME_CONDITION(AMovementCharacter, bReplicatedHanging, COND_SimulatedOnly);
+	DOREPLIFETIME_CONDITION(AMovementCharacter, bReplicatedLedgeClimbing, COND_SimulatedOnly);
+	DOREPLIFETIME_CONDITION(AMovementCharacter, bReplicatedMovingLedgeRight, COND_SimulatedOnly);
+	DOREPLIFETIME_CONDITION(AMovementCharacter, bReplicatedMovingLedgeLeft, COND_SimulatedOnly);
 }
 
+void AMovementCharacter::SetReplicatedClimbState(bool bHanging, bool bLedgeClimbing, bool bMovingRight, bool bMovingLeft)
+{
+	bReplicatedHanging = bHanging;
+	bReplicatedLedgeClimbing = bLedgeClimbing;
+	bReplicatedMovingLedgeRight = bMovingRight;
+	bReplicatedMovingLedgeLeft = bMovingLeft;
+}
 
-void AMovementCharacter::GrabLedge(FVector HeightLocation, FVector WallLocation, FVector WallNormal)
+void AMovementCharacter::OnRep_ClimbState()
 {
-	UObject* pointerToAnyUObject = GetMesh()->GetAnimInstance();
-	ILedgeClimbInterface* LedgeClimb = Cast<ILedgeClimbInterface>(pointerToAnyUObject);
-	if (LedgeClimb)
+	// Other clients only create the component once the character actually climbs
+	if (!Climbing && (bReplicatedHanging || bReplicatedLedgeClimbing))
 	{
-		LedgeClimb->Execute_CanGrab(pointerToAnyUObject, true);
-
-		GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Flying);
-		
-		bIsHanging = true;
-
-		FVector TargetLocation = FVector(WallLocation.X + WallNormal.X*42.0f, WallLocation.Y + WallNormal.Y*42.0f, HeightLocation.Z-GetCapsuleComponent()->GetScaledCapsuleHalfHeight());
-
-		FRotator TargetRotation = WallNormal.Rotation();
-		TargetRotation.Yaw += 180.0f;
-		FLatentActionInfo LatentInfo;
-		LatentInfo.CallbackTarget = this;
-		UKismetSystemLibrary::MoveComponentTo(GetCapsuleComponent(), TargetLocation, TargetRotation, false, false, 0.13f, false, EMoveComponentAction::Move, LatentInfo);
-		
-		GetCharacterMovement()->StopMovementImmediately();
+		EnableClimbing();
+	}
+	if (Climbing)
+	{
+		Climbing->ApplyReplicatedClimbState(bReplicatedHanging, bReplicatedLedgeClimbing, bReplicatedMovingLedgeRight, bReplicatedMovingLedgeLeft);
 	}
-
-
 }
 
 void AMovementCharacter::ExitLedge()
 {
-	if (bIsHanging)
+	if (Climbing)
 	{
-		GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Walking);
-		UObject* pointerToAnyUObject = GetMesh()->GetAnimInstance();
-		ILedgeClimbInterface* LedgeClimb = Cast<ILedgeClimbInterface>(pointerToAnyUObject);
-		if (LedgeClimb)
-		{
-			LedgeClimb->Execute_CanGrab(pointerToAnyUObject, false);
-		}
-		bIsHanging = false;
+		Climbing->ExitLedge();
 	}
 }
 
-void AMovementCharacter::ClimbLedgeEvent()
+void AMovementCharacter::ClimbLedgeEventOver_Implementation()
 {
-	if (!bIsLedgeClimbing)
+	if (Climbing)
 	{
-		UObject* pointerToAnyUObject = GetMesh()->GetAnimInstance();
-		ILedgeClimbInterface* LedgeClimb = Cast<ILedgeClimbInterface>(pointerToAnyUObject);
-		if (LedgeClimb)
-		{
-			LedgeClimb->Execute_ClimbLedge(pointerToAnyUObject, true);
-		}
-		GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Flying);
-		bIsLedgeClimbing = true;
-		bIsHanging = false;
+		Climbing->ClimbLedgeEventOver();
 	}
 }
 
-
-void AMovementCharacter::ClimbLedgeEventOver_Implementation()
+bool AMovementCharacter::ServerGrabLedge_Validate(FVector HeightLocation, FVector WallLocation, FVector WallNormal)
 {
-	UE_LOG(LogTemp, Warning, TEXT("OVER"));
-	bIsLedgeClimbing = false;
-
-	GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Walking);
+	// Malformed input is a kick, an illegal position is only rejected
+	return !HeightLocation.ContainsNaN() && !WallLocation.ContainsNaN() && WallNormal.IsNormalized();
 }
 
-void AMovementCharacter::RightTracer()
+void AMovementCharacter::ServerGrabLedge_Implementation(FVector HeightLocation, FVector WallLocation, FVector WallNormal)
 {
-	if (RightArrow)
+	if (Climbing)
 	{
-		FVector StartTrace = RightArrow->GetComponentLocation();
-		FVector EndTrace = RightArrow->GetComponentLocation();
-
-		float Radius = 20.0f;
-		float HalfHeight = 60.0f;
-		TArray<AActor*> ActorsToIgnore;
-
-		FHitResult Hit;
-
-		if (UKismetSystemLibrary::CapsuleTraceSingle(GetWorld(), StartTrace, EndTrace, Radius, HalfHeight, ETraceTypeQuery::TraceTypeQuery3,
-			false, ActorsToIgnore, EDrawDebugTrace::ForOneFrame, Hit, true))
-		{
-			bCanLedgeMoveRight = true;
-		}
-		else
-		{
-			bCanLedgeMoveRight = false;
-		}
+		Climbing->ServerHandleGrab(HeightLocation, WallLocation, WallNormal);
 	}
 }
 
-void AMovementCharacter::LeftTracer()
+bool AMovementCharacter::ServerShimmyLedge_Validate(FVector NewLocation, bool bRight)
 {
-	if (LeftArrow)
-	{
-		FVector StartTrace = LeftArrow->GetComponentLocation();
-		FVector EndTrace = LeftArrow->GetComponentLocation();
-
-		float Radius = 20.0f;
-		float HalfHeight = 60.0f;
-		TArray<AActor*> ActorsToIgnore;
-
-		FHitResult Hit;
-
-		if (UKismetSystemLibrary::CapsuleTraceSingle(GetWorld(), StartTrace, EndTrace, Radius, HalfHeight, ETraceTypeQuery::TraceTypeQuery3,
-			false, ActorsToIgnore, EDrawDebugTrace::ForOneFrame, Hit, true))
-		{
-			bCanLedgeMoveLeft = true;
-		}
-		else
-		{
-			bCanLedgeMoveLeft = false;
-		}
-	}
+	return !NewLocation.ContainsNaN();
 }
 
-
-
-void AMovementCharacter::LeftJumpTracer()
+void AMovementCharacter::ServerShimmyLedge_Implementation(FVector NewLocation, bool bRight)
 {
-	FVector StartTrace = LeftLedgeJumpArrow->GetComponentLocation();
-	FVector EndTrace = LeftLedgeJumpArrow->GetComponentLocation();
-
-	float Radius = 25.0f;
-	float HalfHeight = 60.0f;
-	TArray<AActor*> ActorsToIgnore;
-
-	FHitResult Hit;
-
-	if (UKismetSystemLibrary::CapsuleTraceSingle(GetWorld(), StartTrace, EndTrace, Radius, HalfHeight, ETraceTypeQuery::TraceTypeQuery3,
-		false, ActorsToIgnore, EDrawDebugTrace::ForOneFrame, Hit, true))
-	{
-		if (bCanLedgeMoveLeft)
-		{
-			bCanLedgeJumpLeft = false;
-		}
-		else
-		{
-			bCanLedgeJumpLeft = true;
-		}
-	}
-	else
+	if (Climbing)
 	{
-		bCanLedgeJumpLeft = false;
+		Climbing->ServerHandleShimmy(NewLocation, bRight);
 	}
 }
 
-void AMovementCharacter::RightJumpTracer()
+bool AMovementCharacter::ServerExitLedge_Validate()
 {
-	FVector StartTrace = RightLedgeJumpArrow->GetComponentLocation();
-	FVector EndTrace = RightLedgeJumpArrow->GetComponentLocation();
+	return true;
+}
 
-	float Radius = 25.0f;
-	float HalfHeight = 60.0f;
-	TArray<AActor*> ActorsToIgnore;
+void AMovementCharacter::ServerExitLedge_Implementation()
+{
+	ExitLedge();
+}
 
-	FHitResult Hit;
+bool AMovementCharacter::ServerClimbLedge_Validate()
+{
+	return true;
+}
 
-	if (UKismetSystemLibrary::CapsuleTraceSingle(GetWorld(), StartTrace, EndTrace, Radius, HalfHeight, ETraceTypeQuery::TraceTypeQuery3,
-		false, ActorsToIgnore, EDrawDebugTrace::ForOneFrame, Hit, true))
-	{
-		if (bCanLedgeMoveRight)
-		{
-			bCanLedgeJumpRight = false;
-		}
-		else
-		{
-			bCanLedgeJumpRight = true;
-		}
-	}
-	else
+void AMovementCharacter::ServerClimbLedge_Implementation()
+{
+	if (Climbing)
 	{
-		bCanLedgeJumpRight = false;
+		Climbing->ServerHandleClimb();
 	}
 }
 
-void AMovementCharacter::Tick(float DeltaSeconds)
+void AMovementCharacter::ClientCorrectGrab_Implementation(bool bAccepted, FVector HeightLocation, FVector WallLocation, FVector WallNormal, UPrimitiveComponent* Base)
 {
-	Super::Tick(DeltaSeconds);
-	RightForwardTracer();
-	RightHeightTracer();
-	LeftForwardTracer();
-	LeftHeightTracer();
-	if (bIsHanging)
+	if (Climbing)
 	{
-		RightTracer();
-		LeftTracer();
-		if (bCanLedgeMoveRight)
-		{
-			bCanLedgeJumpRight = false;
-		}
-		else
-		{
-			RightJumpTracer();
-		}
-		if (bCanLedgeMoveLeft)
-		{
-			bCanLedgeJumpLeft = false;
-		}
-		else
-		{
-			LeftJumpTracer();
-		}
+		Climbing->ClientHandleCorrection(bAccepted, HeightLocation, WallLocation, WallNormal, Base);
 	}
 }
 
 void AMovementCharacter::Jump()
 {
-	if (bIsHanging)
-	{
-		ClimbLedgeEvent();
-	}
-	else
+	if (!Climbing || !Climbing->HandleJump())
 	{
 		ACharacter::Jump();
 	}
@@ -522,6 +255,12 @@ void AMovementCharacter::StopJumping()
 
 void AMovementCharacter::MoveForward(float Value)
 {
+	if (Climbing)
+	{
+		Climbing->HandleMoveForward(Value);
+	}
+
+	const bool bIsHanging = Climbing && Climbing->IsHanging();
 	if (!bIsHanging && (Controller != NULL) && (Value != 0.0f))
 	{
 		// find out which way is forward
@@ -536,40 +275,12 @@ void AMovementCharacter::MoveForward(float Value)
 
 void AMovementCharacter::MoveRight(float Value)
 {
-
-	if (bIsHanging)
-
+	if (Climbing && Climbing->HandleMoveRight(Value))
 	{
-		if (Value > 0.0f && bCanLedgeMoveRight)
-		{
-			FVector NewLocation = UKismetMathLibrary::VInterpTo(GetActorLocation(), FRotationMatrix(GetActorRotation()).GetScaledAxis(EAxis::Y) * 20.0f + GetActorLocation(), GetWorld()->DeltaTimeSeconds, 5);
-			SetActorLocation(NewLocation);
-			bMovingLedgeRight = true;
-			bMovingLedgeLeft = false;
-		}
-
-		else if (Value < 0.0f && bCanLedgeMoveLeft)
-		{
-			FVector NewLocation = UKismetMathLibrary::VInterpTo(GetActorLocation(), FRotationMatrix(GetActorRotation()).GetScaledAxis(EAxis::Y) * -20.0f + GetActorLocation(), GetWorld()->DeltaTimeSeconds, 5);
-			SetActorLocation(NewLocation);
-			bMovingLedgeRight = false;
-			bMovingLedgeLeft = true;
-
-		}
-		else if (Value > 0.0f && GetCharacterMovement()->IsFalling())
-		{
-
-		}
-		else if (Value == 0.0f)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("Not Moving"));
-			bMovingLedgeRight = false;
-			bMovingLedgeLeft = false;
-		}
+		return;
 	}
 
-
-	if (!bIsHanging && (Controller != NULL) && (Value != 0.0f))
+	if ((Controller != NULL) && (Value != 0.0f))
 	{
 		// find out which way is right
 		const FRotator Rotation = Controller->GetControlRotation();
@@ -30,7 +30,23 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category=Camera)
 	float BaseLookUpRate;
 
-	float ClimbArrowRadius;
+	/** Climb without a player controlling the character, player controlled characters always get a UClimbingComponent */
+	UPROPERTY(EditDefaultsOnly, Category = "LedgeClimbing")
+	uint8 bCanClimb : 1;
+
+	/** Class of the climbing component created on demand, a blueprint subclass carries the climbing tunables */
+	UPROPERTY(EditDefaultsOnly, Category = "LedgeClimbing")
+	TSubclassOf<class UClimbingComponent> ClimbingComponentClass;
+
+	/** Creates the climbing component if the character does not have one yet */
+	void EnableClimbing();
+
+	FORCEINLINE class UClimbingComponent* GetClimbing() const { return Climbing; }
+
+	/** Server only, sets the hang, climb and shimmy state simulated proxies play */
+	void SetReplicatedClimbState(bool bHanging, bool bLedgeClimbing, bool bMovingRight, bool bMovingLeft);
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 protected:
 
@@ -55,99 +71,71 @@ protected:
 	 * @param Rate	This is a normalized rate, i.e. 1.0 means 100% of desired turn rate
 	 */
 	void LookUpAtRate(float Rate);
-	
-	void RightForwardTracer();
-
-	void RightHeightTracer();
-
-	void LeftForwardTracer();
-
-	void LeftHeightTracer();
-
-	bool bRightSuccessfulForwardTrace;
-
-	bool bLeftSuccessfulForwardTrace;
-
-	FVector RightHeightLocation;
-
-	FVector RightWallLocation;
-
-	FVector RightWallNormal;
-
-	FVector LeftHeightLocation;
-
-	FVector LeftWallLocation;
 
-	FVector LeftWallNormal;
+	void ExitLedge();
 
-	bool bIsLedgeClimbing;
+	UFUNCTION(Server, Reliable, WithValidation)
+	void ServerGrabLedge(FVector HeightLocation, FVector WallLocation, FVector WallNormal);
 
-	bool bIsHanging;
+	UFUNCTION(Server, Unreliable, WithValidation)
+	void ServerShimmyLedge(FVector NewLocation, bool bRight);
 
-	void GrabLedge(FVector HeightLocation, FVector WallLocation, FVector WallNormal);
+	UFUNCTION(Server, Reliable, WithValidation)
+	void ServerExitLedge();
 
-	void ExitLedge();
+	UFUNCTION(Server, Reliable, WithValidation)
+	void ServerClimbLedge();
 
-	void ClimbLedgeEvent();
+	/** Tells the owning client its grab was corrected, or rejected when bAccepted is false, Base is the ledge's primitive when the server knows it */
+	UFUNCTION(Client, Reliable)
+	void ClientCorrectGrab(bool bAccepted, FVector HeightLocation, FVector WallLocation, FVector WallNormal, class UPrimitiveComponent* Base);
 
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "AnimMessage")
 	void ClimbLedgeEventOver();
 	virtual void ClimbLedgeEventOver_Implementation();
 
-	// Forward Tracing Arrows
-	UPROPERTY(VisibleAnywhere, Category = "Components")
-	UArrowComponent* LeftClimbArrow;
-
-	UPROPERTY(VisibleAnywhere, Category = "Components")
-	UArrowComponent* RightClimbArrow;
-
-	UPROPERTY(VisibleAnywhere, Category = "Components")
-	UArrowComponent* LeftClimbArrow2;
-
-	UPROPERTY(VisibleAnywhere, Category = "Components")
-	UArrowComponent* RightClimbArrow2;
-
-	// Move Left and Right Arrows
-	UPROPERTY(VisibleAnywhere, Category = "Components")
-	UArrowComponent* LeftArrow;
-
-	UPROPERTY(VisibleAnywhere, Category = "Components")
-	UArrowComponent* RightArrow;
-	
-	void RightTracer();
-	void LeftTracer();
-
+	// Mirrored from the climbing component for ThirdPerson_AnimBP, which reads them off the character
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "LedgeClimbing")
-	bool bCanLedgeMoveRight;
+	uint8 bCanLedgeMoveRight : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "LedgeClimbing")
-	bool bCanLedgeMoveLeft;
+	uint8 bCanLedgeMoveLeft : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "LedgeClimbing")
-	bool bMovingLedgeRight;
+	uint8 bMovingLedgeRight : 1;
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "LedgeClimbing")
-	bool bMovingLedgeLeft;
+	uint8 bMovingLedgeLeft : 1;
 
-	UPROPERTY(VisibleAnywhere, Category = "Components")
-	UArrowComponent*  LeftLedgeJumpArrow;
-	
-	UPROPERTY(VisibleAnywhere, Category = "Components")
-	UArrowComponent*  RightLedgeJumpArrow;
+	/** Hang and climb state for other clients, whose copies of this character do not run the ledge probes */
+	UPROPERTY(ReplicatedUsing = OnRep_ClimbState)
+	uint8 bReplicatedHanging : 1;
 
-	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "LedgeClimbing")
-	bool bCanLedgeJumpLeft;
+	UPROPERTY(ReplicatedUsing = OnRep_ClimbState)
+	uint8 bReplicatedLedgeClimbing : 1;
 
-	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "LedgeClimbing")
-	bool bCanLedgeJumpRight;
+	UPROPERTY(ReplicatedUsing = OnRep_ClimbState)
+	uint8 bReplicatedMovingLedgeRight : 1;
+
+	UPROPERTY(ReplicatedUsing = OnRep_ClimbState)
+	uint8 bReplicatedMovingLedgeLeft : 1;
 
-	void LeftJumpTracer();
-	void RightJumpTracer();
-	
+	UFUNCTION()
+	void OnRep_ClimbState();
 
+	/** Created on demand, null for characters that do not climb */
+	UPROPERTY(Transient)
+	class UClimbingComponent* Climbing;
+
+	friend class UClimbingComponent;
 
 protected:
-	virtual void Tick(float DeltaSeconds) override;
+	virtual void BeginPlay() override;
+
+	// APawn interface, player controlled characters start climbing on possession
+	virtual void PossessedBy(AController* NewController) override;
+	virtual void PawnClientRestart() override;
+	// End of APawn interface
 
 	// APawn interface
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
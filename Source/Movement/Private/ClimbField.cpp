@@ -0,0 +1,340 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbField.h"
+#include "LedgeData.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/Level.h"
+#include "GameFramework/Actor.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+
+// Voxel intervals covered by one brick, its last samples are the first of the next brick
+static const int32 BrickSpan = FClimbFieldBrick::Size - 1;
+
+static int32 GetVoxelIndex(int32 X, int32 Y, int32 Z)
+{
+	return (Z * FClimbFieldBrick::Size + Y) * FClimbFieldBrick::Size + X;
+}
+
+// 64 bit finalizer, neighbouring cells differ in few bits and would cluster under a plain truncation
+static uint32 HashCell(uint64 Cell)
+{
+	Cell ^= Cell >> 33;
+	Cell *= 0xff51afd7ed558ccdULL;
+	Cell ^= Cell >> 33;
+	return (uint32)Cell;
+}
+
+static uint64 GetCell(const FClimbFieldHeader& Header, int32 BrickX, int32 BrickY, int32 BrickZ)
+{
+	return ((uint64)BrickZ * Header.BricksY + BrickY) * Header.BricksX + BrickX;
+}
+
+// Bricks start on a 4KB boundary so each one sits in a single page of the mapping
+static int64 GetBricksOffset(uint32 HashSize)
+{
+	return Align((int64)sizeof(FClimbFieldHeader) + (int64)HashSize * sizeof(FClimbFieldSlot), (int64)sizeof(FClimbFieldBrick));
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FClimbFieldView
+
+FClimbFieldView::FClimbFieldView()
+	: Header(nullptr)
+	, Slots(nullptr)
+	, Bricks(nullptr)
+{
+}
+
+bool FClimbFieldView::Initialize(const uint8* Data, int64 Size)
+{
+	Header = nullptr;
+	if (!Data || Size < (int64)sizeof(FClimbFieldHeader))
+	{
+		return false;
+	}
+
+	const FClimbFieldHeader* Candidate = reinterpret_cast<const FClimbFieldHeader*>(Data);
+	if (Candidate->Magic != FClimbFieldHeader::ExpectedMagic || Candidate->Version != FClimbFieldHeader::ExpectedVersion ||
+		Candidate->BricksX <= 0 || Candidate->BricksY <= 0 || Candidate->BricksZ <= 0 || Candidate->VoxelSize <= 0.0f ||
+		!FMath::IsPowerOfTwo(Candidate->HashSize) || Candidate->HashSize < Candidate->NumBricks)
+	{
+		return false;
+	}
+
+	const int64 BricksOffset = GetBricksOffset(Candidate->HashSize);
+	if (Size < BricksOffset + (int64)Candidate->NumBricks * sizeof(FClimbFieldBrick))
+	{
+		return false;
+	}
+
+	Header = Candidate;
+	Slots = reinterpret_cast<const FClimbFieldSlot*>(Data + sizeof(FClimbFieldHeader));
+	Bricks = reinterpret_cast<const FClimbFieldBrick*>(Data + BricksOffset);
+	return true;
+}
+
+const FClimbFieldBrick* FClimbFieldView::FindBrick(uint64 Cell) const
+{
+	const uint32 Mask = Header->HashSize - 1;
+	uint32 Slot = HashCell(Cell) & Mask;
+	for (uint32 Probe = 0; Probe < Header->HashSize; ++Probe)
+	{
+		const FClimbFieldSlot& Entry = Slots[Slot];
+		if (Entry.Brick == FClimbFieldHeader::EmptyBrick)
+		{
+			return nullptr;
+		}
+		if (Entry.Cell == Cell)
+		{
+			// Out of range indices are only caught here, the slots are never scanned up front
+			return Entry.Brick < Header->NumBricks ? &Bricks[Entry.Brick] : nullptr;
+		}
+		Slot = (Slot + 1) & Mask;
+	}
+	return nullptr;
+}
+
+bool FClimbFieldView::Sample(const FVector& Location, FClimbSurfaceSample& OutSample) const
+{
+	if (!Header)
+	{
+		return false;
+	}
+
+	const FVector Local = (Location - Header->Origin) / Header->VoxelSize;
+	const int32 BrickX = FMath::FloorToInt(Local.X / BrickSpan);
+	const int32 BrickY = FMath::FloorToInt(Local.Y / BrickSpan);
+	const int32 BrickZ = FMath::FloorToInt(Local.Z / BrickSpan);
+	if (BrickX < 0 || BrickY < 0 || BrickZ < 0 || BrickX >= Header->BricksX || BrickY >= Header->BricksY || BrickZ >= Header->BricksZ)
+	{
+		return false;
+	}
+
+	const FClimbFieldBrick* FoundBrick = FindBrick(GetCell(*Header, BrickX, BrickY, BrickZ));
+	if (!FoundBrick)
+	{
+		return false;
+	}
+	const FClimbFieldBrick& Brick = *FoundBrick;
+
+	const FVector InBrick = Local - FVector(BrickX, BrickY, BrickZ) * BrickSpan;
+	const int32 X = FMath::Clamp(FMath::FloorToInt(InBrick.X), 0, BrickSpan - 1);
+	const int32 Y = FMath::Clamp(FMath::FloorToInt(InBrick.Y), 0, BrickSpan - 1);
+	const int32 Z = FMath::Clamp(FMath::FloorToInt(InBrick.Z), 0, BrickSpan - 1);
+	const FVector Alpha(
+		FMath::Clamp(InBrick.X - X, 0.0f, 1.0f),
+		FMath::Clamp(InBrick.Y - Y, 0.0f, 1.0f),
+		FMath::Clamp(InBrick.Z - Z, 0.0f, 1.0f));
+
+	float Distance = 0.0f;
+	float LedgeHeight = 0.0f;
+	FVector Normal = FVector::ZeroVector;
+	bool bHasLedge = true;
+	for (int32 Corner = 0; Corner < 8; ++Corner)
+	{
+		const int32 DX = Corner & 1;
+		const int32 DY = (Corner >> 1) & 1;
+		const int32 DZ = (Corner >> 2) & 1;
+		const float Weight = (DX ? Alpha.X : 1.0f - Alpha.X) * (DY ? Alpha.Y : 1.0f - Alpha.Y) * (DZ ? Alpha.Z : 1.0f - Alpha.Z);
+		const FClimbFieldVoxel& Voxel = Brick.Voxels[GetVoxelIndex(X + DX, Y + DY, Z + DZ)];
+
+		Distance += Weight * Voxel.Distance;
+		Normal += Weight * FVector(Voxel.Normal[0], Voxel.Normal[1], Voxel.Normal[2]);
+
+		// A ledge only counts when every corner sees one, blending with the sentinel is meaningless
+		bHasLedge &= Voxel.LedgeHeight != FClimbFieldVoxel::NoLedge;
+		LedgeHeight += Weight * Voxel.LedgeHeight;
+	}
+
+	OutSample.Distance = Distance / FClimbFieldVoxel::UnitScale;
+	OutSample.Normal = Normal.GetSafeNormal();
+	OutSample.bHasLedge = bHasLedge;
+	OutSample.LedgeHeight = bHasLedge ? LedgeHeight / FClimbFieldVoxel::UnitScale : 0.0f;
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FClimbFieldBuilder
+
+/** Distance from Point to the primitive's collision, using its bounds where it has no simple collision */
+static float GetDistanceToPrimitive(const UPrimitiveComponent* Primitive, const FVector& Point, FVector& OutClosestPoint)
+{
+	const float Distance = Primitive->GetDistanceToCollision(Point, OutClosestPoint);
+	if (Distance >= 0.0f)
+	{
+		return Distance;
+	}
+
+	const FTransform& Transform = Primitive->GetComponentTransform();
+	const FBox LocalBox = Primitive->CalcBounds(FTransform::Identity).GetBox();
+	OutClosestPoint = Transform.TransformPosition(LocalBox.GetClosestPointTo(Transform.InverseTransformPosition(Point)));
+	return FVector::Dist(OutClosestPoint, Point);
+}
+
+static int16 QuantizeLength(float Length)
+{
+	return (int16)FMath::Clamp(FMath::RoundToInt(Length * FClimbFieldVoxel::UnitScale), -MAX_int16, (int32)MAX_int16);
+}
+
+void FClimbFieldBuilder::Bake(const ULevel* Level, const TArray<FLedgeSegment>& Ledges, float VoxelSize, float Band, TArray<uint8>& OutData)
+{
+	const ECollisionChannel LedgeChannel = UEngineTypes::ConvertToCollisionChannel(ETraceTypeQuery::TraceTypeQuery3);
+
+	TArray<const UPrimitiveComponent*> Climbable;
+	FBox Bounds(ForceInit);
+	for (const AActor* Actor : Level->Actors)
+	{
+		if (!Actor)
+		{
+			continue;
+		}
+
+		TInlineComponentArray<UPrimitiveComponent*> Primitives(Actor);
+		for (const UPrimitiveComponent* Primitive : Primitives)
+		{
+			// Anything that can move would leave its distances behind, physics finds it instead
+			if (Primitive->Mobility == EComponentMobility::Static && Primitive->IsCollisionEnabled() &&
+				Primitive->GetCollisionResponseToChannel(LedgeChannel) == ECR_Block)
+			{
+				Climbable.Add(Primitive);
+				Bounds += Primitive->Bounds.GetBox().ExpandBy(Band);
+			}
+		}
+	}
+	if (!Bounds.IsValid)
+	{
+		Bounds = FBox(FVector::ZeroVector, FVector::ZeroVector);
+	}
+
+	// Nearest ledge lookups go through the same binned layout the runtime uses
+	TArray<uint8> LedgeBlob;
+	FLedgeDataBuilder::Serialize(Ledges, TArray<FBox>(), 1000.0f, LedgeBlob);
+	FLedgeDataView LedgeView;
+	LedgeView.Initialize(LedgeBlob.GetData(), LedgeBlob.Num());
+
+	const float BrickExtent = BrickSpan * VoxelSize;
+	FClimbFieldHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = FClimbFieldHeader::ExpectedMagic;
+	Header.Version = FClimbFieldHeader::ExpectedVersion;
+	Header.Origin = Bounds.Min;
+	Header.VoxelSize = VoxelSize;
+	Header.BricksX = FMath::Max(1, FMath::CeilToInt((Bounds.Max.X - Bounds.Min.X) / BrickExtent));
+	Header.BricksY = FMath::Max(1, FMath::CeilToInt((Bounds.Max.Y - Bounds.Min.Y) / BrickExtent));
+	Header.BricksZ = FMath::Max(1, FMath::CeilToInt((Bounds.Max.Z - Bounds.Min.Z) / BrickExtent));
+
+	// Only cells within the band of some primitive get a brick, walking each primitive's cells never visits the empty volume
+	TMap<uint64, TArray<const UPrimitiveComponent*>> CellPrimitives;
+	for (const UPrimitiveComponent* Primitive : Climbable)
+	{
+		const FBox Box = Primitive->Bounds.GetBox().ExpandBy(Band);
+		const FVector MinCell = (Box.Min - Header.Origin) / BrickExtent;
+		const FVector MaxCell = (Box.Max - Header.Origin) / BrickExtent;
+		const int32 MinX = FMath::Clamp(FMath::FloorToInt(MinCell.X), 0, Header.BricksX - 1);
+		const int32 MinY = FMath::Clamp(FMath::FloorToInt(MinCell.Y), 0, Header.BricksY - 1);
+		const int32 MinZ = FMath::Clamp(FMath::FloorToInt(MinCell.Z), 0, Header.BricksZ - 1);
+		const int32 MaxX = FMath::Clamp(FMath::FloorToInt(MaxCell.X), 0, Header.BricksX - 1);
+		const int32 MaxY = FMath::Clamp(FMath::FloorToInt(MaxCell.Y), 0, Header.BricksY - 1);
+		const int32 MaxZ = FMath::Clamp(FMath::FloorToInt(MaxCell.Z), 0, Header.BricksZ - 1);
+		for (int32 BrickZ = MinZ; BrickZ <= MaxZ; ++BrickZ)
+		{
+			for (int32 BrickY = MinY; BrickY <= MaxY; ++BrickY)
+			{
+				for (int32 BrickX = MinX; BrickX <= MaxX; ++BrickX)
+				{
+					CellPrimitives.FindOrAdd(GetCell(Header, BrickX, BrickY, BrickZ)).Add(Primitive);
+				}
+			}
+		}
+	}
+
+	// Bricks in cell order, so neighbouring bricks are mostly close in the file too
+	CellPrimitives.KeySort(TLess<uint64>());
+
+	TArray<uint64> BrickCells;
+	TArray<FClimbFieldBrick> Bricks;
+	BrickCells.Reserve(CellPrimitives.Num());
+	Bricks.Reserve(CellPrimitives.Num());
+
+	for (const TPair<uint64, TArray<const UPrimitiveComponent*>>& CellPair : CellPrimitives)
+	{
+		const uint64 Cell = CellPair.Key;
+		const TArray<const UPrimitiveComponent*>& Nearby = CellPair.Value;
+		const int32 BrickX = (int32)(Cell % Header.BricksX);
+		const int32 BrickY = (int32)((Cell / Header.BricksX) % Header.BricksY);
+		const int32 BrickZ = (int32)(Cell / ((uint64)Header.BricksX * Header.BricksY));
+		const FVector BrickMin = Header.Origin + FVector(BrickX, BrickY, BrickZ) * BrickExtent;
+
+		BrickCells.Add(Cell);
+		FClimbFieldBrick& Brick = Bricks[Bricks.AddZeroed()];
+		for (int32 Z = 0; Z < FClimbFieldBrick::Size; ++Z)
+		{
+			for (int32 Y = 0; Y < FClimbFieldBrick::Size; ++Y)
+			{
+				for (int32 X = 0; X < FClimbFieldBrick::Size; ++X)
+				{
+					const FVector Point = BrickMin + FVector(X, Y, Z) * VoxelSize;
+					float Distance = MAX_flt;
+					FVector SurfacePoint = Point;
+					for (const UPrimitiveComponent* Primitive : Nearby)
+					{
+						FVector Closest;
+						const float PrimitiveDistance = GetDistanceToPrimitive(Primitive, Point, Closest);
+						if (PrimitiveDistance < Distance)
+						{
+							Distance = PrimitiveDistance;
+							SurfacePoint = Closest;
+						}
+					}
+
+					FClimbFieldVoxel& Voxel = Brick.Voxels[GetVoxelIndex(X, Y, Z)];
+					Voxel.Distance = QuantizeLength(Distance);
+
+					// Samples inside geometry keep a zero normal and drop out of the interpolated one
+					const FVector Normal = (Point - SurfacePoint).GetSafeNormal();
+					Voxel.Normal[0] = (int8)FMath::RoundToInt(Normal.X * 127.0f);
+					Voxel.Normal[1] = (int8)FMath::RoundToInt(Normal.Y * 127.0f);
+					Voxel.Normal[2] = (int8)FMath::RoundToInt(Normal.Z * 127.0f);
+
+					FVector LedgePoint;
+					Voxel.LedgeHeight = LedgeView.FindNearestSegment(Point, Band, LedgePoint)
+						? QuantizeLength(LedgePoint.Z - Point.Z) : FClimbFieldVoxel::NoLedge;
+				}
+			}
+		}
+	}
+
+	// At most half full, so a lookup probes a slot or two
+	Header.NumBricks = Bricks.Num();
+	Header.HashSize = FMath::RoundUpToPowerOfTwo(FMath::Max(1u, Header.NumBricks * 2));
+
+	TArray<FClimbFieldSlot> Slots;
+	Slots.AddZeroed(Header.HashSize);
+	for (FClimbFieldSlot& Slot : Slots)
+	{
+		Slot.Brick = FClimbFieldHeader::EmptyBrick;
+	}
+	for (int32 BrickIndex = 0; BrickIndex < BrickCells.Num(); ++BrickIndex)
+	{
+		uint32 Slot = HashCell(BrickCells[BrickIndex]) & (Header.HashSize - 1);
+		while (Slots[Slot].Brick != FClimbFieldHeader::EmptyBrick)
+		{
+			Slot = (Slot + 1) & (Header.HashSize - 1);
+		}
+		Slots[Slot].Cell = BrickCells[BrickIndex];
+		Slots[Slot].Brick = BrickIndex;
+	}
+
+	OutData.Reset();
+	OutData.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+	OutData.Append(reinterpret_cast<const uint8*>(Slots.GetData()), Slots.Num() * sizeof(FClimbFieldSlot));
+	OutData.AddZeroed(GetBricksOffset(Header.HashSize) - OutData.Num());
+	OutData.Append(reinterpret_cast<const uint8*>(Bricks.GetData()), Bricks.Num() * sizeof(FClimbFieldBrick));
+}
+
+FString FClimbFieldBuilder::GetClimbFieldFilename(const ULevel* Level)
+{
+	const FString PackageName = UWorld::RemovePIEPrefix(Level->GetOutermost()->GetName());
+	return FLedgeDataBuilder::GetDataDirectory() / FPackageName::GetShortName(PackageName) + TEXT(".climbfield");
+}
@@ -0,0 +1,142 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbProbeBudget.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ConfigCacheIni.h"
+
+static int32 GClimbProbeBudgetEnabled = 0;
+static FAutoConsoleVariableRef CVarClimbProbeBudget(
+	TEXT("climbing.ProbeBudget"),
+	GClimbProbeBudgetEnabled,
+	TEXT("Count climbing scene queries per frame and warn when a scenario goes over its budget in DefaultGame.ini"));
+
+static const TCHAR* ProbeBudgetSection = TEXT("ClimbProbeBudgets");
+
+FClimbProbeBudget& FClimbProbeBudget::Get()
+{
+	static FClimbProbeBudget Budget;
+	return Budget;
+}
+
+FClimbProbeBudget::FClimbProbeBudget()
+{
+	Reset();
+	LoadBudgets();
+}
+
+bool FClimbProbeBudget::IsEnabled() const
+{
+	return GClimbProbeBudgetEnabled != 0;
+}
+
+void FClimbProbeBudget::RecordFrame(EClimbScenario Scenario, int32 SceneQueries)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	FScenarioStats& Stats = Scenarios[(int32)Scenario];
+	if (SceneQueries > Stats.MaxFrameQueries && Stats.Budget != INDEX_NONE && SceneQueries > Stats.Budget)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Climb scenario %s issued %d scene queries in one frame, budget is %d"),
+			GetScenarioName(Scenario), SceneQueries, Stats.Budget);
+	}
+	++Stats.Frames;
+	Stats.SceneQueries += SceneQueries;
+	Stats.MaxFrameQueries = FMath::Max(Stats.MaxFrameQueries, SceneQueries);
+}
+
+bool FClimbProbeBudget::LogReport() const
+{
+	bool bWithinBudget = true;
+	for (int32 Index = 0; Index < (int32)EClimbScenario::Count; ++Index)
+	{
+		const FScenarioStats& Stats = Scenarios[Index];
+		const TCHAR* Name = GetScenarioName((EClimbScenario)Index);
+		if (Stats.Frames == 0)
+		{
+			UE_LOG(LogTemp, Display, TEXT("%s: not seen"), Name);
+			continue;
+		}
+
+		const bool bOver = Stats.Budget != INDEX_NONE && Stats.MaxFrameQueries > Stats.Budget;
+		bWithinBudget &= !bOver;
+		if (bOver)
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s: %u frames, %llu scene queries, worst frame %d, budget %d, OVER"),
+				Name, Stats.Frames, Stats.SceneQueries, Stats.MaxFrameQueries, Stats.Budget);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Display, TEXT("%s: %u frames, %llu scene queries, worst frame %d, budget %d"),
+				Name, Stats.Frames, Stats.SceneQueries, Stats.MaxFrameQueries, Stats.Budget);
+		}
+	}
+	return bWithinBudget;
+}
+
+void FClimbProbeBudget::Reset()
+{
+	for (FScenarioStats& Stats : Scenarios)
+	{
+		Stats.Frames = 0;
+		Stats.SceneQueries = 0;
+		Stats.MaxFrameQueries = 0;
+	}
+}
+
+void FClimbProbeBudget::LoadBudgets()
+{
+	for (int32 Index = 0; Index < (int32)EClimbScenario::Count; ++Index)
+	{
+		int32 Budget = INDEX_NONE;
+		if (GConfig)
+		{
+			GConfig->GetInt(ProbeBudgetSection, GetScenarioName((EClimbScenario)Index), Budget, GGameIni);
+		}
+		Scenarios[Index].Budget = Budget;
+	}
+}
+
+const TCHAR* FClimbProbeBudget::GetScenarioName(EClimbScenario Scenario)
+{
+	switch (Scenario)
+	{
+	case EClimbScenario::Idle: return TEXT("Idle");
+	case EClimbScenario::AlongWall: return TEXT("AlongWall");
+	case EClimbScenario::Grab: return TEXT("Grab");
+	case EClimbScenario::Hanging: return TEXT("Hanging");
+	case EClimbScenario::Shimmy: return TEXT("Shimmy");
+	case EClimbScenario::ClimbUp: return TEXT("ClimbUp");
+	case EClimbScenario::Exit: return TEXT("Exit");
+	default: return TEXT("Unknown");
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Console commands
+
+static FAutoConsoleCommand ClimbProbeBudgetReportCommand(
+	TEXT("Climbing.ProbeBudgetReport"),
+	TEXT("Logs scene queries per climb scenario against the budgets, needs climbing.ProbeBudget set while playing"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		if (FClimbProbeBudget::Get().LogReport())
+		{
+			UE_LOG(LogTemp, Display, TEXT("Climb probe budgets: all scenarios within budget"));
+		}
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("Climb probe budgets: over budget"));
+		}
+	}));
+
+static FAutoConsoleCommand ClimbProbeBudgetResetCommand(
+	TEXT("Climbing.ProbeBudgetReset"),
+	TEXT("Clears the recorded climb scenario counts and rereads the budgets"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FClimbProbeBudget::Get().Reset();
+		FClimbProbeBudget::Get().LoadBudgets();
+	}));
@@ -0,0 +1,265 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbTrace.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformAtomics.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static int32 GClimbTraceEnabled = 0;
+static FAutoConsoleVariableRef CVarClimbTrace(
+	TEXT("climbing.Trace"),
+	GClimbTraceEnabled,
+	TEXT("Record climb action stage timestamps for Climbing.TraceExport and Climbing.TraceHistogram"));
+
+// Upper bounds of the latency histogram buckets in milliseconds, roughly in frames at 60Hz
+static const double HistogramBucketsMs[] = { 1.0, 4.0, 8.0, 17.0, 34.0, 67.0, 134.0, 267.0 };
+static const int32 NumHistogramBuckets = ARRAY_COUNT(HistogramBucketsMs) + 1;
+
+FClimbTrace& FClimbTrace::Get()
+{
+	static FClimbTrace Trace;
+	return Trace;
+}
+
+FClimbTrace::FClimbTrace()
+{
+	Reset();
+}
+
+bool FClimbTrace::IsEnabled() const
+{
+	return GClimbTraceEnabled != 0;
+}
+
+uint32 FClimbTrace::BeginAction(EClimbAction Action)
+{
+	if (!IsEnabled())
+	{
+		return 0;
+	}
+	const uint32 ActionId = (uint32)FPlatformAtomics::InterlockedIncrement(&NextActionId);
+	Record(ActionId, Action, EClimbStage::Input);
+	return ActionId;
+}
+
+void FClimbTrace::MarkStage(uint32 ActionId, EClimbAction Action, EClimbStage Stage)
+{
+	if (ActionId != 0)
+	{
+		Record(ActionId, Action, Stage);
+	}
+}
+
+void FClimbTrace::Reset()
+{
+	FMemory::Memzero(Events);
+	WriteIndex = 0;
+	NextActionId = 0;
+}
+
+void FClimbTrace::Record(uint32 ActionId, EClimbAction Action, EClimbStage Stage)
+{
+	const int32 Index = FPlatformAtomics::InterlockedIncrement(&WriteIndex) - 1;
+	FClimbTraceEvent& Event = Events[Index & (Capacity - 1)];
+
+	Event.Sequence = 0;
+	FPlatformMisc::MemoryBarrier();
+	Event.ActionId = ActionId;
+	Event.Action = Action;
+	Event.Stage = Stage;
+	Event.Frame = GFrameCounter;
+	Event.Cycles = FPlatformTime::Cycles64();
+	FPlatformMisc::MemoryBarrier();
+	Event.Sequence = Index + 1;
+}
+
+void FClimbTrace::Snapshot(TArray<FClimbTraceEvent>& OutEvents) const
+{
+	const int32 End = WriteIndex;
+	const int32 Start = FMath::Max(0, End - Capacity);
+	OutEvents.Reset(End - Start);
+	for (int32 Index = Start; Index < End; ++Index)
+	{
+		const FClimbTraceEvent& Event = Events[Index & (Capacity - 1)];
+		if (Event.Sequence != Index + 1)
+		{
+			continue;
+		}
+
+		// A writer may claim the slot while it is copied, the copy only counts if the sequence is unchanged after it
+		FPlatformMisc::MemoryBarrier();
+		const FClimbTraceEvent Copy = Event;
+		FPlatformMisc::MemoryBarrier();
+		if (Event.Sequence == Index + 1)
+		{
+			OutEvents.Add(Copy);
+		}
+	}
+}
+
+bool FClimbTrace::ExportChromeTrace(const FString& Filename) const
+{
+	TArray<FClimbTraceEvent> Snapshot;
+	this->Snapshot(Snapshot);
+	if (Snapshot.Num() == 0)
+	{
+		return false;
+	}
+
+	const double SecondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+	const uint64 BaseCycles = Snapshot[0].Cycles;
+	auto ToMicroseconds = [SecondsPerCycle, BaseCycles](uint64 Cycles)
+	{
+		return (double)(Cycles - BaseCycles) * SecondsPerCycle * 1000000.0;
+	};
+
+	// One instant event per stage on the action's own row, plus a span from first to last stage
+	TMap<uint32, TPair<const FClimbTraceEvent*, const FClimbTraceEvent*>> Spans;
+	FString Json = TEXT("{\"traceEvents\":[\n");
+	for (const FClimbTraceEvent& Event : Snapshot)
+	{
+		Json += FString::Printf(TEXT("{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"frame\":%llu}},\n"),
+			GetStageName(Event.Stage), GetActionName(Event.Action), ToMicroseconds(Event.Cycles), Event.ActionId, Event.Frame);
+
+		TPair<const FClimbTraceEvent*, const FClimbTraceEvent*>* Span = Spans.Find(Event.ActionId);
+		if (Span)
+		{
+			Span->Value = &Event;
+		}
+		else
+		{
+			Spans.Add(Event.ActionId, TPair<const FClimbTraceEvent*, const FClimbTraceEvent*>(&Event, &Event));
+		}
+	}
+	for (const auto& Pair : Spans)
+	{
+		const FClimbTraceEvent& First = *Pair.Value.Key;
+		const FClimbTraceEvent& Last = *Pair.Value.Value;
+		Json += FString::Printf(TEXT("{\"name\":\"%s\",\"cat\":\"climb\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"frames\":%llu}},\n"),
+			GetActionName(First.Action), ToMicroseconds(First.Cycles), ToMicroseconds(Last.Cycles) - ToMicroseconds(First.Cycles),
+			Pair.Key, Last.Frame - First.Frame);
+	}
+	Json.RemoveFromEnd(TEXT(",\n"));
+	Json += TEXT("\n]}\n");
+
+	return FFileHelper::SaveStringToFile(Json, *Filename);
+}
+
+void FClimbTrace::LogHistograms() const
+{
+	TArray<FClimbTraceEvent> Snapshot;
+	this->Snapshot(Snapshot);
+
+	// Latency runs from the Input stage to the latest stage seen for the same action
+	TMap<uint32, TPair<const FClimbTraceEvent*, const FClimbTraceEvent*>> Spans;
+	for (const FClimbTraceEvent& Event : Snapshot)
+	{
+		if (Event.Stage == EClimbStage::Input)
+		{
+			Spans.Add(Event.ActionId, TPair<const FClimbTraceEvent*, const FClimbTraceEvent*>(&Event, &Event));
+		}
+		else if (TPair<const FClimbTraceEvent*, const FClimbTraceEvent*>* Span = Spans.Find(Event.ActionId))
+		{
+			Span->Value = &Event;
+		}
+	}
+
+	int32 Counts[(int32)EClimbAction::Count][NumHistogramBuckets] = {};
+	double MaxMs[(int32)EClimbAction::Count] = {};
+	uint64 MaxFrames[(int32)EClimbAction::Count] = {};
+	for (const auto& Pair : Spans)
+	{
+		const FClimbTraceEvent& First = *Pair.Value.Key;
+		const FClimbTraceEvent& Last = *Pair.Value.Value;
+		const int32 Action = (int32)First.Action;
+		const double Ms = (double)(Last.Cycles - First.Cycles) * FPlatformTime::GetSecondsPerCycle64() * 1000.0;
+
+		int32 Bucket = 0;
+		while (Bucket < NumHistogramBuckets - 1 && Ms >= HistogramBucketsMs[Bucket])
+		{
+			++Bucket;
+		}
+		++Counts[Action][Bucket];
+		MaxMs[Action] = FMath::Max(MaxMs[Action], Ms);
+		MaxFrames[Action] = FMath::Max(MaxFrames[Action], Last.Frame - First.Frame);
+	}
+
+	for (int32 Action = 0; Action < (int32)EClimbAction::Count; ++Action)
+	{
+		FString Line;
+		for (int32 Bucket = 0; Bucket < NumHistogramBuckets; ++Bucket)
+		{
+			if (Bucket < NumHistogramBuckets - 1)
+			{
+				Line += FString::Printf(TEXT(" <%.0fms:%d"), HistogramBucketsMs[Bucket], Counts[Action][Bucket]);
+			}
+			else
+			{
+				Line += FString::Printf(TEXT(" more:%d"), Counts[Action][Bucket]);
+			}
+		}
+		UE_LOG(LogTemp, Display, TEXT("%s latency%s (max %.2f ms, %llu frames)"),
+			GetActionName((EClimbAction)Action), *Line, MaxMs[Action], MaxFrames[Action]);
+	}
+}
+
+const TCHAR* FClimbTrace::GetActionName(EClimbAction Action)
+{
+	switch (Action)
+	{
+	case EClimbAction::Grab: return TEXT("Grab");
+	case EClimbAction::ClimbUp: return TEXT("ClimbUp");
+	case EClimbAction::Shimmy: return TEXT("Shimmy");
+	case EClimbAction::Exit: return TEXT("Exit");
+	default: return TEXT("Unknown");
+	}
+}
+
+const TCHAR* FClimbTrace::GetStageName(EClimbStage Stage)
+{
+	switch (Stage)
+	{
+	case EClimbStage::Input: return TEXT("Input");
+	case EClimbStage::StateChange: return TEXT("StateChange");
+	case EClimbStage::AnimInterface: return TEXT("AnimInterface");
+	case EClimbStage::Complete: return TEXT("Complete");
+	default: return TEXT("Unknown");
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Console commands
+
+static FAutoConsoleCommand ClimbTraceExportCommand(
+	TEXT("Climbing.TraceExport"),
+	TEXT("Writes recorded climb action stages as Chrome trace JSON, optionally to the given file"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const FString Filename = Args.Num() > 0 ? Args[0] : FPaths::ProfilingDir() / TEXT("ClimbTrace.json");
+		if (FClimbTrace::Get().ExportChromeTrace(Filename))
+		{
+			UE_LOG(LogTemp, Display, TEXT("Wrote climb trace to %s"), *Filename);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("No climb trace written, is climbing.Trace enabled?"));
+		}
+	}));
+
+static FAutoConsoleCommand ClimbTraceHistogramCommand(
+	TEXT("Climbing.TraceHistogram"),
+	TEXT("Logs per action climb latency histograms from the recorded trace"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FClimbTrace::Get().LogHistograms();
+	}));
+
+static FAutoConsoleCommand ClimbTraceResetCommand(
+	TEXT("Climbing.TraceReset"),
+	TEXT("Clears the recorded climb trace"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FClimbTrace::Get().Reset();
+	}));
@@ -0,0 +1,954 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbingComponent.h"
+#include "Movement.h"
+#include "ClimbProbeBudget.h"
+#include "MovementCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "WorldCollision.h"
+#include "LedgeClimbInterface.h"
+#include "LedgeData.h"
+
+// Where the shimmy probes check that the ledge continues, mirrored in Y for the left side
+static const FVector LedgeMoveProbeOffset(40.0f, 60.0f, 40.0f);
+
+// How far in front of the character the height probes come down onto the ledge top
+static const float HeightProbeDistance = 70.0f;
+
+// Distance from the wall to the centre of the hanging capsule
+static const float HangWallDistance = 42.0f;
+
+// How far the capsule may drift from its hang location before the ledge is probed again
+static const float HangLocationTolerance = 1.0f;
+
+// How long moving the capsule onto a grabbed ledge takes
+static const float GrabMoveTime = 0.13f;
+
+// Each frame of a shimmy interpolates toward a point this far to the side at this rate, so it moves at their product
+static const float ShimmyStepDistance = 20.0f;
+static const float ShimmyInterpSpeed = 5.0f;
+
+// How far a claimed shimmy step may stray from the character's right axis
+static const float ShimmyOffAxisTolerance = 2.0f;
+
+// A remote character whose shimmy steps stop arriving for this long has stopped shimmying
+static const float ShimmyStepTimeout = 0.25f;
+
+// Changes when the primitive's collision shape or its response to the ledge channel changes, not when it moves
+static uint32 GetCollisionSignature(const UPrimitiveComponent* Primitive)
+{
+	const FBoxSphereBounds LocalBounds = Primitive->CalcBounds(FTransform::Identity);
+	uint32 Signature = PointerHash(Primitive->GetBodySetup());
+	Signature = HashCombine(Signature, GetTypeHash(LocalBounds.Origin));
+	Signature = HashCombine(Signature, GetTypeHash(LocalBounds.BoxExtent));
+	Signature = HashCombine(Signature, GetTypeHash(Primitive->GetComponentScale()));
+	Signature = HashCombine(Signature, (uint32)Primitive->GetCollisionEnabled());
+	Signature = HashCombine(Signature, (uint32)Primitive->GetCollisionResponseToChannel(UEngineTypes::ConvertToCollisionChannel(ETraceTypeQuery::TraceTypeQuery3)));
+	return Signature;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FClimbLedgeProbe
+
+void FClimbLedgeProbe::SetWall(UPrimitiveComponent* InBase, const FVector& InWallLocation, const FVector& InWallNormal)
+{
+	Base = InBase;
+	const FTransform BaseTransform = GetBaseTransform();
+	WallLocation = BaseTransform.InverseTransformPosition(InWallLocation);
+	WallNormal = BaseTransform.InverseTransformVectorNoScale(InWallNormal);
+}
+
+void FClimbLedgeProbe::SetHeight(const FVector& InHeightLocation)
+{
+	HeightLocation = GetBaseTransform().InverseTransformPosition(InHeightLocation);
+}
+
+FVector FClimbLedgeProbe::GetHeightLocation() const
+{
+	return GetBaseTransform().TransformPosition(HeightLocation);
+}
+
+FVector FClimbLedgeProbe::GetWallLocation() const
+{
+	return GetBaseTransform().TransformPosition(WallLocation);
+}
+
+FVector FClimbLedgeProbe::GetWallNormal() const
+{
+	return GetBaseTransform().TransformVectorNoScale(WallNormal);
+}
+
+FTransform FClimbLedgeProbe::GetBaseTransform() const
+{
+	const UPrimitiveComponent* Primitive = Base.Get();
+	return Primitive ? Primitive->GetComponentTransform() : FTransform::Identity;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// UClimbingComponent
+
+UClimbingComponent::UClimbingComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = true;
+
+	ClimbArrowRadius = 10.0f;
+	ClimbProbeSpacing = 21.0f;
+	LedgeReachDistance = 150.0f;
+	LedgeHeightProbeOffset = 100.0f;
+	ClimbValidationTolerance = 20.0f;
+	HopCandidatesPerFrame = 2;
+
+	bCanLedgeMoveRight = false;
+	bCanLedgeMoveLeft = false;
+	bMovingLedgeRight = false;
+	bMovingLedgeLeft = false;
+	bCanLedgeJumpLeft = false;
+	bCanLedgeJumpRight = false;
+	bHasHopTarget = false;
+	bIsHanging = false;
+	bIsLedgeClimbing = false;
+
+	Ledge.Hanging.HangLocation = FVector::ZeroVector;
+	Ledge.Hanging.HangRotation = FQuat::Identity;
+	Ledge.Hanging.CollisionSignature = 0;
+	Ledge.Hanging.MoveTimeLeft = 0.0f;
+	Ledge.Hanging.bSettled = false;
+	LedgeInput = FVector2D::ZeroVector;
+	FMemory::Memzero(ClimbTraceIds);
+	FMemory::Memzero(ClimbTraceEffectFrames);
+	FrameSceneQueries = 0;
+	ActionScenario = EClimbScenario::Count;
+	bReachNeedsPhysics = false;
+	ShimmyPaidUntil = 0.0f;
+	LastShimmyStepTime = 0.0f;
+	LastFrameSceneQueries = 0;
+	LastFrameScenario = EClimbScenario::Idle;
+}
+
+void UClimbingComponent::OnRegister()
+{
+	Super::OnRegister();
+	CharacterOwner = Cast<AMovementCharacter>(GetOwner());
+	check(CharacterOwner);
+
+	// Based movement has carried the capsule along with a moving ledge by the time it is checked
+	AddTickPrerequisiteComponent(CharacterOwner->GetCharacterMovement());
+}
+
+bool UClimbingComponent::HandleJump()
+{
+	if (bIsHanging)
+	{
+		BeginClimbTrace(EClimbAction::ClimbUp);
+		if (GetOwnerRole() == ROLE_AutonomousProxy)
+		{
+			CharacterOwner->ServerClimbLedge();
+		}
+		ClimbLedgeEvent();
+		return true;
+	}
+	return false;
+}
+
+void UClimbingComponent::HandleMoveForward(float Value)
+{
+	LedgeInput.Y = Value;
+}
+
+bool UClimbingComponent::HandleMoveRight(float Value)
+{
+	LedgeInput.X = Value;
+
+	if (!bIsHanging)
+	{
+		return false;
+	}
+
+	const FVector ActorLocation = CharacterOwner->GetActorLocation();
+	const FVector RightAxis = FRotationMatrix(CharacterOwner->GetActorRotation()).GetScaledAxis(EAxis::Y);
+	bool bNewShimmy = false;
+	if ((Value > 0.0f && bCanLedgeMoveRight) || (Value < 0.0f && bCanLedgeMoveLeft))
+	{
+		const bool bRight = Value > 0.0f;
+
+		// Only the start of a shimmy is traced, not every frame of it
+		bNewShimmy = bRight ? !bMovingLedgeRight : !bMovingLedgeLeft;
+		if (bNewShimmy)
+		{
+			BeginClimbTrace(EClimbAction::Shimmy);
+		}
+		FVector NewLocation = UKismetMathLibrary::VInterpTo(ActorLocation, RightAxis * (bRight ? ShimmyStepDistance : -ShimmyStepDistance) + ActorLocation,
+			GetWorld()->DeltaTimeSeconds, ShimmyInterpSpeed);
+		CharacterOwner->SetActorLocation(NewLocation);
+		if (GetOwnerRole() == ROLE_AutonomousProxy)
+		{
+			CharacterOwner->ServerShimmyLedge(NewLocation, bRight);
+		}
+		bMovingLedgeRight = bRight;
+		bMovingLedgeLeft = !bRight;
+		if (bNewShimmy)
+		{
+			MarkClimbTrace(EClimbAction::Shimmy, EClimbStage::StateChange);
+		}
+	}
+	else if (Value == 0.0f)
+	{
+		bMovingLedgeRight = false;
+		bMovingLedgeLeft = false;
+	}
+	SyncAnimFlags();
+	if (bNewShimmy)
+	{
+		MarkClimbTrace(EClimbAction::Shimmy, EClimbStage::AnimInterface);
+		CompleteClimbTraceNextFrame(EClimbAction::Shimmy);
+	}
+	return true;
+}
+
+bool UClimbingComponent::ShouldRunLedgeProbes() const
+{
+	return CharacterOwner->IsLocallyControlled() || GetNetMode() == NM_Standalone;
+}
+
+FVector UClimbingComponent::GetClimbProbeLocation(float Side, float Spread) const
+{
+	const float Y = Side * (ClimbProbeSpacing + Spread * ClimbArrowRadius);
+	return CharacterOwner->GetActorTransform().TransformPosition(FVector(0.0f, Y, 0.0f));
+}
+
+bool UClimbingComponent::ReachTracer()
+{
+	INC_DWORD_STAT(STAT_ClimbReachProbes);
+
+	// Box spanning both forward probe pairs and the height probe range above them
+	const float HalfReach = LedgeReachDistance / 2.0f;
+	const float HalfHeight = LedgeHeightProbeOffset / 2.0f;
+	const FVector HalfExtent(HalfReach + ClimbArrowRadius, ClimbProbeSpacing + 2.0f * ClimbArrowRadius, HalfHeight + ClimbArrowRadius);
+	const FVector Center = CharacterOwner->GetActorLocation() + CharacterOwner->GetActorForwardVector() * HalfReach + FVector(0.0f, 0.0f, HalfHeight);
+	const FQuat Rotation = CharacterOwner->GetActorQuat();
+
+	// Baked ledge data describes the static boxes of levels that have it, physics still has to find
+	// everything movable and any static primitive the bake left out
+	FCollisionQueryParams Params(FName(TEXT("LedgeReach")), false, CharacterOwner);
+	bool bBakedLedge = false;
+	const FLedgeDataRegistry& LedgeData = FLedgeDataRegistry::Get();
+	if (LedgeData.CoversWorld(GetWorld()))
+	{
+		const FBox ReachBox = FBox(-HalfExtent, HalfExtent).TransformBy(FTransform(Rotation, Center));
+		bBakedLedge = LedgeData.AnySegmentInBox(GetWorld(), ReachBox);
+		if (!LedgeData.AnyUnbakedInBox(GetWorld(), ReachBox))
+		{
+			Params.MobilityType = EQueryMobilityType::Dynamic;
+		}
+	}
+
+	++FrameSceneQueries;
+	bReachNeedsPhysics = GetWorld()->OverlapBlockingTestByChannel(Center, Rotation, UEngineTypes::ConvertToCollisionChannel(ETraceTypeQuery::TraceTypeQuery3),
+		FCollisionShape::MakeBox(HalfExtent), Params);
+	if (bBakedLedge || bReachNeedsPhysics)
+	{
+		return true;
+	}
+
+	INC_DWORD_STAT(STAT_ClimbReachRejects);
+	return false;
+}
+
+bool UClimbingComponent::ForwardTracer(float Side, FClimbLedgeProbe& Probe)
+{
+	INC_DWORD_STAT(STAT_ClimbForwardProbes);
+
+	FVector StartTrace = GetClimbProbeLocation(Side, -1.0f);
+	FVector StartTrace2 = GetClimbProbeLocation(Side, 1.0f);
+
+	// The baked climb field finds the wall with two lookups instead of two sweeps, unless the reach volume holds geometry it does not know about
+	const FLedgeDataRegistry& LedgeData = FLedgeDataRegistry::Get();
+	if (!bReachNeedsPhysics && LedgeData.FieldCoversWorld(GetWorld()))
+	{
+		const FVector Forward = CharacterOwner->GetActorForwardVector();
+		auto IsOnProbePath = [this, &Forward](const FVector& Start, const FClimbSurfaceSample& Sample)
+		{
+			// The field gives the nearest surface in any direction, it is the first wall ahead only if it faces the
+			// probe from within the sphere's path
+			const FVector Offset = -Sample.Normal * Sample.Distance;
+			const float Along = FVector::DotProduct(Offset, Forward);
+			return Along > 0.0f && (Offset - Forward * Along).SizeSquared() <= FMath::Square(ClimbArrowRadius) &&
+				FVector::DotProduct(Sample.Normal, -Forward) > 0.7f;
+		};
+		auto HasLedgeInRange = [this](const FClimbSurfaceSample& Sample)
+		{
+			return Sample.bHasLedge && Sample.LedgeHeight >= 0.0f && Sample.LedgeHeight <= LedgeHeightProbeOffset;
+		};
+
+		// Nothing climbable anywhere within reach means nothing ahead either
+		FClimbSurfaceSample Sample;
+		FClimbSurfaceSample Sample2;
+		if (!LedgeData.SampleClimbField(GetWorld(), StartTrace, Sample) || !LedgeData.SampleClimbField(GetWorld(), StartTrace2, Sample2) ||
+			Sample.Distance > LedgeReachDistance || Sample2.Distance > LedgeReachDistance)
+		{
+			INC_DWORD_STAT(STAT_ClimbForwardRejects);
+			return false;
+		}
+
+		// Something off to the side is nearer than whatever is ahead, only the sweeps can tell what that is
+		if (IsOnProbePath(StartTrace, Sample) && IsOnProbePath(StartTrace2, Sample2))
+		{
+			if (HasLedgeInRange(Sample) && HasLedgeInRange(Sample2) && Sample.Normal.Equals(Sample2.Normal, 0.05f))
+			{
+				Probe.SetWall(nullptr, StartTrace - Sample.Normal * Sample.Distance, Sample.Normal);
+				return true;
+			}
+
+			INC_DWORD_STAT(STAT_ClimbForwardRejects);
+			return false;
+		}
+	}
+
+	FVector EndTrace = CharacterOwner->GetActorRotation().Vector();
+	EndTrace.X *= LedgeReachDistance;
+	EndTrace.Y *= LedgeReachDistance;
+	FVector EndTrace2 = EndTrace + StartTrace2;
+	EndTrace += StartTrace;
+
+	FHitResult Hit;
+	FHitResult Hit2;
+
+	if (LedgeSphereTrace(StartTrace, EndTrace, false, true, Hit) &&
+		LedgeSphereTrace(StartTrace2, EndTrace2, false, true, Hit2) &&
+		Hit.Normal.Equals(Hit2.Normal))
+	{
+		Probe.SetWall(Hit.GetComponent(), Hit.ImpactPoint, Hit.Normal);
+		return true;
+	}
+
+	INC_DWORD_STAT(STAT_ClimbForwardRejects);
+	return false;
+}
+
+void UClimbingComponent::HeightTracer(float Side, FClimbLedgeProbe& Probe)
+{
+	INC_DWORD_STAT(STAT_ClimbHeightProbes);
+
+	// Start just above the wall the forward probes found rather than high over the character
+	FVector ForwardDirection = CharacterOwner->GetActorRotation().Vector() * HeightProbeDistance;
+	FVector EndTrace = GetClimbProbeLocation(Side, -1.0f) + ForwardDirection;
+	FVector EndTrace2 = GetClimbProbeLocation(Side, 1.0f) + ForwardDirection;
+	FVector StartTrace = EndTrace;
+	FVector StartTrace2 = EndTrace2;
+	const FVector WallLocation = Probe.GetWallLocation();
+	StartTrace.Z = WallLocation.Z + LedgeHeightProbeOffset;
+	StartTrace2.Z = WallLocation.Z + LedgeHeightProbeOffset;
+
+	FHitResult Hit;
+	FHitResult Hit2;
+
+	if (LedgeSphereTrace(StartTrace, EndTrace, false, true, Hit) &&
+		LedgeSphereTrace(StartTrace2, EndTrace2, false, true, Hit2))
+	{
+		Probe.SetHeight(Hit.ImpactPoint);
+		float PelvisDuringImpact = CharacterOwner->GetMesh()->GetSocketLocation("PelvisSocket").Z - Hit.ImpactPoint.Z;
+		float MinHeight = -50.0f;
+		float MaxHeight = 0.0f;
+		if (MinHeight < PelvisDuringImpact && PelvisDuringImpact < MaxHeight)
+		{
+			if (!bIsLedgeClimbing)
+			{
+				GrabLedge(Hit.ImpactPoint, WallLocation, Probe.GetWallNormal(), Hit.GetComponent());
+			}
+		}
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_ClimbHeightRejects);
+	}
+}
+
+bool UClimbingComponent::LedgeSphereTrace(const FVector& Start, const FVector& End, bool bIgnoreOwner, bool bDrawDebug, FHitResult& Hit) const
+{
+	++FrameSceneQueries;
+	TArray<AActor*> ActorsToIgnore;
+	if (bIgnoreOwner)
+	{
+		ActorsToIgnore.Add(CharacterOwner);
+	}
+	return UKismetSystemLibrary::SphereTraceSingle(GetWorld(), Start, End, ClimbArrowRadius, ETraceTypeQuery::TraceTypeQuery3,
+		false, ActorsToIgnore, bDrawDebug ? EDrawDebugTrace::ForOneFrame : EDrawDebugTrace::None, Hit, true);
+}
+
+bool UClimbingComponent::SideTracer(float Side) const
+{
+	FVector Offset = LedgeMoveProbeOffset;
+	Offset.Y *= Side;
+	FVector StartTrace = CharacterOwner->GetActorTransform().TransformPosition(Offset);
+	FVector EndTrace = StartTrace;
+
+	float Radius = 20.0f;
+	float HalfHeight = 60.0f;
+	TArray<AActor*> ActorsToIgnore;
+
+	FHitResult Hit;
+
+	++FrameSceneQueries;
+	return UKismetSystemLibrary::CapsuleTraceSingle(GetWorld(), StartTrace, EndTrace, Radius, HalfHeight, ETraceTypeQuery::TraceTypeQuery3,
+		false, ActorsToIgnore, EDrawDebugTrace::ForOneFrame, Hit, true);
+}
+
+void UClimbingComponent::GrabLedge(FVector HeightLocation, FVector WallLocation, FVector WallNormal, UPrimitiveComponent* Base)
+{
+	UObject* pointerToAnyUObject = CharacterOwner->GetMesh()->GetAnimInstance();
+	ILedgeClimbInterface* LedgeClimb = Cast<ILedgeClimbInterface>(pointerToAnyUObject);
+	if (LedgeClimb)
+	{
+		// Grabbing is re-run every frame while hanging to keep the capsule snapped, only trace the first
+		const bool bNewGrab = !bIsHanging;
+		if (bNewGrab)
+		{
+			BeginClimbTrace(EClimbAction::Grab);
+			ActionScenario = EClimbScenario::Grab;
+			if (GetOwnerRole() == ROLE_AutonomousProxy)
+			{
+				CharacterOwner->ServerGrabLedge(HeightLocation, WallLocation, WallNormal);
+			}
+		}
+
+		LedgeClimb->Execute_CanGrab(pointerToAnyUObject, true);
+		if (bNewGrab)
+		{
+			MarkClimbTrace(EClimbAction::Grab, EClimbStage::AnimInterface);
+		}
+
+		CharacterOwner->GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Flying);
+
+		// Flying drops the movement base, hanging from a moving ledge makes based movement carry the capsule along
+		if (Base && Base->Mobility == EComponentMobility::Movable && CharacterOwner->GetMovementBase() != Base)
+		{
+			CharacterOwner->SetBase(Base);
+		}
+
+		bIsHanging = true;
+		if (bNewGrab)
+		{
+			MarkClimbTrace(EClimbAction::Grab, EClimbStage::StateChange);
+		}
+
+		UCapsuleComponent* Capsule = CharacterOwner->GetCapsuleComponent();
+		FVector TargetLocation = FVector(WallLocation.X + WallNormal.X*HangWallDistance, WallLocation.Y + WallNormal.Y*HangWallDistance, HeightLocation.Z - Capsule->GetScaledCapsuleHalfHeight());
+
+		FRotator TargetRotation = WallNormal.Rotation();
+		TargetRotation.Yaw += 180.0f;
+
+		const FTransform BaseTransform = Base ? Base->GetComponentTransform() : FTransform::Identity;
+		const FVector BaseTarget = BaseTransform.InverseTransformPosition(TargetLocation);
+
+		// Grabbing the same spot again leaves a running move alone, a move restarted every frame would never finish
+		const bool bNewTarget = bNewGrab || Ledge.Hanging.Base.Get() != Base || !Ledge.Hanging.HangLocation.Equals(BaseTarget, HangLocationTolerance);
+
+		Ledge.Hanging.Base = Base;
+		Ledge.Hanging.CollisionSignature = Base ? GetCollisionSignature(Base) : 0;
+		if (bNewTarget)
+		{
+			Ledge.Hanging.HangLocation = BaseTarget;
+			Ledge.Hanging.HangRotation = BaseTransform.InverseTransformRotation(TargetRotation.Quaternion());
+			Ledge.Hanging.MoveTimeLeft = GrabMoveTime;
+			Ledge.Hanging.bSettled = false;
+			MoveToHangLocation(TargetLocation, TargetRotation, GrabMoveTime);
+		}
+
+		CharacterOwner->GetCharacterMovement()->StopMovementImmediately();
+	}
+}
+
+bool UClimbingComponent::IsHangingLedgeCurrent() const
+{
+	// Without a base the ledge cannot be told apart from one that moved, so it is always probed again,
+	// and until the grab move finishes there is no settled hang location to compare against
+	const UPrimitiveComponent* Base = Ledge.Hanging.Base.Get();
+	if (!Base || !Ledge.Hanging.bSettled || GetCollisionSignature(Base) != Ledge.Hanging.CollisionSignature)
+	{
+		return false;
+	}
+
+	// Shimmying means the ledge under the hands may differ
+	const FVector HangLocation = Base->GetComponentTransform().TransformPosition(Ledge.Hanging.HangLocation);
+	return CharacterOwner->GetActorLocation().Equals(HangLocation, HangLocationTolerance);
+}
+
+void UClimbingComponent::UpdateGrabMove(float DeltaTime)
+{
+	const UPrimitiveComponent* Base = Ledge.Hanging.Base.Get();
+	if (!bIsHanging || Ledge.Hanging.bSettled || !Base || Base->Mobility != EComponentMobility::Movable)
+	{
+		return;
+	}
+
+	// MoveComponentTo heads for a fixed world location, so it is restarted towards where the base has taken the ledge,
+	// over what is left of the move so it still ends on time
+	Ledge.Hanging.MoveTimeLeft -= DeltaTime;
+	if (Ledge.Hanging.MoveTimeLeft > 0.0f)
+	{
+		const FTransform& BaseTransform = Base->GetComponentTransform();
+		MoveToHangLocation(BaseTransform.TransformPosition(Ledge.Hanging.HangLocation),
+			BaseTransform.TransformRotation(Ledge.Hanging.HangRotation).Rotator(), Ledge.Hanging.MoveTimeLeft);
+	}
+}
+
+void UClimbingComponent::MoveToHangLocation(const FVector& TargetLocation, const FRotator& TargetRotation, float OverTime)
+{
+	FLatentActionInfo LatentInfo;
+	LatentInfo.CallbackTarget = this;
+	LatentInfo.ExecutionFunction = FName(TEXT("GrabLedgeMoveFinished"));
+	LatentInfo.Linkage = 0;
+	LatentInfo.UUID = 1;
+	UKismetSystemLibrary::MoveComponentTo(CharacterOwner->GetCapsuleComponent(), TargetLocation, TargetRotation, false, false, OverTime, false, EMoveComponentAction::Move, LatentInfo);
+}
+
+void UClimbingComponent::GrabLedgeMoveFinished()
+{
+	// Where the move actually left the capsule is what later frames are compared against
+	const UPrimitiveComponent* Base = Ledge.Hanging.Base.Get();
+	if (bIsHanging && Base)
+	{
+		Ledge.Hanging.HangLocation = Base->GetComponentTransform().InverseTransformPosition(CharacterOwner->GetActorLocation());
+	}
+	Ledge.Hanging.bSettled = true;
+	MarkClimbTrace(EClimbAction::Grab, EClimbStage::Complete);
+}
+
+void UClimbingComponent::ExitLedge()
+{
+	if (bIsHanging)
+	{
+		BeginClimbTrace(EClimbAction::Exit);
+		ActionScenario = EClimbScenario::Exit;
+		if (GetOwnerRole() == ROLE_AutonomousProxy)
+		{
+			CharacterOwner->ServerExitLedge();
+		}
+		CharacterOwner->GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Walking);
+		bIsHanging = false;
+		Ledge.Hanging.Base = nullptr;
+		HopSearch.Reset();
+		bHasHopTarget = false;
+		MarkClimbTrace(EClimbAction::Exit, EClimbStage::StateChange);
+
+		UObject* pointerToAnyUObject = CharacterOwner->GetMesh()->GetAnimInstance();
+		ILedgeClimbInterface* LedgeClimb = Cast<ILedgeClimbInterface>(pointerToAnyUObject);
+		if (LedgeClimb)
+		{
+			LedgeClimb->Execute_CanGrab(pointerToAnyUObject, false);
+			MarkClimbTrace(EClimbAction::Exit, EClimbStage::AnimInterface);
+		}
+
+		// Falling only shows once character movement has run in the new mode
+		CompleteClimbTraceNextFrame(EClimbAction::Exit);
+	}
+}
+
+void UClimbingComponent::ClimbLedgeEvent()
+{
+	if (!bIsLedgeClimbing)
+	{
+		UObject* pointerToAnyUObject = CharacterOwner->GetMesh()->GetAnimInstance();
+		ILedgeClimbInterface* LedgeClimb = Cast<ILedgeClimbInterface>(pointerToAnyUObject);
+		if (LedgeClimb)
+		{
+			LedgeClimb->Execute_ClimbLedge(pointerToAnyUObject, true);
+			MarkClimbTrace(EClimbAction::ClimbUp, EClimbStage::AnimInterface);
+		}
+		CharacterOwner->GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Flying);
+		bIsLedgeClimbing = true;
+		bIsHanging = false;
+		Ledge.Hanging.Base = nullptr;
+		HopSearch.Reset();
+		bHasHopTarget = false;
+		MarkClimbTrace(EClimbAction::ClimbUp, EClimbStage::StateChange);
+	}
+}
+
+void UClimbingComponent::ClimbLedgeEventOver()
+{
+	bIsLedgeClimbing = false;
+
+	CharacterOwner->GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Walking);
+	MarkClimbTrace(EClimbAction::ClimbUp, EClimbStage::Complete);
+}
+
+void UClimbingComponent::BeginClimbTrace(EClimbAction Action)
+{
+	ClimbTraceIds[(int32)Action] = FClimbTrace::Get().BeginAction(Action);
+}
+
+void UClimbingComponent::CompleteClimbTraceNextFrame(EClimbAction Action)
+{
+	if (ClimbTraceIds[(int32)Action] != 0)
+	{
+		ClimbTraceEffectFrames[(int32)Action] = GFrameCounter;
+	}
+}
+
+void UClimbingComponent::MarkClimbTrace(EClimbAction Action, EClimbStage Stage)
+{
+	FClimbTrace::Get().MarkStage(ClimbTraceIds[(int32)Action], Action, Stage);
+	if (Stage == EClimbStage::Complete)
+	{
+		ClimbTraceIds[(int32)Action] = 0;
+	}
+}
+
+void UClimbingComponent::UpdateHopSearch()
+{
+	// GrabLedge hangs the capsule centre HangWallDistance out from the edge and a half height below it
+	const FVector HandOffset(HangWallDistance, 0.0f, CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight());
+	HopSearch.Update(CharacterOwner, HandOffset, Ledge.Hanging.Base.Get(), LedgeInput, ClimbArrowRadius, HopCandidatesPerFrame);
+	FrameSceneQueries += HopSearch.GetSceneQueriesLastUpdate();
+
+	// Hops only make sense where the ledge does not simply continue
+	bCanLedgeJumpRight = !bCanLedgeMoveRight && HopSearch.HasTargetToSide(1.0f);
+	bCanLedgeJumpLeft = !bCanLedgeMoveLeft && HopSearch.HasTargetToSide(-1.0f);
+
+	const FLedgeHopCandidate* Best = HopSearch.GetBest();
+	bHasHopTarget = Best != nullptr;
+	if (Best)
+	{
+		HopTargetLocation = Best->GetLedgeLocation();
+	}
+}
+
+void UClimbingComponent::SyncAnimFlags()
+{
+	CharacterOwner->bCanLedgeMoveRight = bCanLedgeMoveRight;
+	CharacterOwner->bCanLedgeMoveLeft = bCanLedgeMoveLeft;
+	CharacterOwner->bMovingLedgeRight = bMovingLedgeRight;
+	CharacterOwner->bMovingLedgeLeft = bMovingLedgeLeft;
+}
+
+bool UClimbingComponent::ValidateLedgeGrab(FVector& HeightLocation, FVector& WallLocation, FVector& WallNormal, UPrimitiveComponent*& OutBase) const
+{
+	OutBase = nullptr;
+
+	SCOPE_CYCLE_COUNTER(STAT_ClimbValidateGrab);
+	INC_DWORD_STAT(STAT_ClimbValidationRequests);
+
+	// Cheap bound first, the ledge has to be within what the forward and height probes could reach
+	const FVector ActorLocation = CharacterOwner->GetActorLocation();
+	const float MaxReach = LedgeReachDistance + LedgeHeightProbeOffset + ClimbValidationTolerance;
+	if (FVector::DistSquared(HeightLocation, ActorLocation) > FMath::Square(MaxReach) ||
+		FVector::DistSquared(WallLocation, ActorLocation) > FMath::Square(MaxReach))
+	{
+		INC_DWORD_STAT(STAT_ClimbValidationRejects);
+		return false;
+	}
+
+	// The height probes come down HeightProbeDistance in front of a character at least a capsule radius off the wall,
+	// so the claimed top lies up to that far past the edge, only its height has to match closely
+	const float MaxInset = HeightProbeDistance - CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius() + ClimbValidationTolerance;
+
+	// GrabLedge moves the capsule out from the wall, so the wall is found here rather than taken from the client
+	FVector ServerWall;
+	FVector ServerNormal;
+	float LedgeHeight;
+
+	// Baked ledges are static, so they need no base. A ledge the baked data does not have may be on something
+	// movable, the sweeps find it and the primitive the server has to base the character on
+	const FLedgeDataRegistry& LedgeData = FLedgeDataRegistry::Get();
+	FLedgeSegment Segment;
+	if (LedgeData.CoversWorld(GetWorld()) &&
+		LedgeData.FindNearestSegment(GetWorld(), HeightLocation, FVector2D(MaxInset, ClimbValidationTolerance).Size(), Segment, ServerWall) &&
+		FMath::Abs(ServerWall.Z - HeightLocation.Z) <= ClimbValidationTolerance)
+	{
+		// The edge below the claimed top is the wall point
+		ServerNormal = Segment.WallNormal;
+		LedgeHeight = ServerWall.Z;
+	}
+	else
+	{
+		// One sweep down through the claimed ledge top confirms it
+		const FVector StartTrace = HeightLocation + FVector(0.0f, 0.0f, ClimbValidationTolerance);
+		const FVector EndTrace = HeightLocation - FVector(0.0f, 0.0f, ClimbValidationTolerance);
+
+		FHitResult Hit;
+
+		if (!LedgeSphereTrace(StartTrace, EndTrace, true, false, Hit) ||
+			Hit.bStartPenetrating || Hit.ImpactNormal.Z <= 0.7f)
+		{
+			INC_DWORD_STAT(STAT_ClimbValidationRejects);
+			return false;
+		}
+		LedgeHeight = Hit.ImpactPoint.Z;
+		OutBase = Hit.GetComponent();
+
+		// and one across through the claimed wall, just under that top, finds where the wall really is
+		const FVector WallProbe(WallLocation.X, WallLocation.Y, LedgeHeight - 2.0f * ClimbArrowRadius);
+		const FVector WallDirection = WallNormal.GetSafeNormal2D();
+
+		FHitResult WallHit;
+
+		if (!LedgeSphereTrace(WallProbe + WallDirection * ClimbValidationTolerance, WallProbe - WallDirection * ClimbValidationTolerance, true, false, WallHit) ||
+			WallHit.bStartPenetrating || FVector::DotProduct(WallHit.ImpactNormal, WallDirection) <= 0.7f)
+		{
+			INC_DWORD_STAT(STAT_ClimbValidationRejects);
+			return false;
+		}
+		ServerWall = WallHit.ImpactPoint;
+		ServerNormal = WallHit.ImpactNormal.GetSafeNormal2D();
+	}
+
+	// The claimed wall has to be where the server found it, and the claimed top on the ledge above it
+	const float Inset = FVector::DotProduct(HeightLocation - ServerWall, -ServerNormal);
+	if ((WallLocation - ServerWall).SizeSquared2D() > FMath::Square(ClimbValidationTolerance) ||
+		Inset < -ClimbValidationTolerance || Inset > MaxInset)
+	{
+		INC_DWORD_STAT(STAT_ClimbValidationRejects);
+		return false;
+	}
+
+	if (!FMath::IsNearlyEqual(LedgeHeight, HeightLocation.Z, 1.0f) || (WallLocation - ServerWall).SizeSquared2D() > 1.0f ||
+		!WallNormal.Equals(ServerNormal, 0.05f))
+	{
+		INC_DWORD_STAT(STAT_ClimbValidationCorrections);
+	}
+	HeightLocation.Z = LedgeHeight;
+	WallLocation = FVector(ServerWall.X, ServerWall.Y, WallLocation.Z);
+	WallNormal = ServerNormal;
+	return true;
+}
+
+bool UClimbingComponent::ValidateLedgeShimmy(const FVector& NewLocation, bool bRight, float& OutPaidUntil) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ClimbValidateShimmy);
+	INC_DWORD_STAT(STAT_ClimbValidationRequests);
+
+	// The step has to run along the ledge, to the side the client says it is shimmying
+	const FVector Delta = NewLocation - CharacterOwner->GetActorLocation();
+	const FVector RightAxis = CharacterOwner->GetActorRightVector();
+	const float Along = FVector::DotProduct(Delta, RightAxis);
+	if (!bIsHanging || (Delta - RightAxis * Along).SizeSquared() > FMath::Square(ShimmyOffAxisTolerance) || (bRight ? Along : -Along) < 0.0f)
+	{
+		INC_DWORD_STAT(STAT_ClimbValidationRejects);
+		return false;
+	}
+
+	// Every step costs the time shimmying takes to cover it. Unreliable steps arrive bunched up, so time saved up while
+	// none arrived may be spent, but no more than one full step's worth
+	const float ShimmySpeed = ShimmyStepDistance * ShimmyInterpSpeed;
+	const float Now = GetWorld()->GetTimeSeconds();
+	OutPaidUntil = FMath::Max(ShimmyPaidUntil, Now - ShimmyStepDistance / ShimmySpeed) + FMath::Abs(Along) / ShimmySpeed;
+	if (OutPaidUntil > Now)
+	{
+		INC_DWORD_STAT(STAT_ClimbValidationRejects);
+		return false;
+	}
+
+	// GrabLedge hangs the capsule HangWallDistance out from the wall and a half height below the top, so the hands are on the edge
+	const FVector HandLocation = NewLocation + CharacterOwner->GetActorForwardVector() * HangWallDistance
+		+ FVector(0.0f, 0.0f, CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight());
+
+	// Ledges on movable primitives are not baked, a step the baked data cannot confirm is swept
+	const FLedgeDataRegistry& LedgeData = FLedgeDataRegistry::Get();
+	FLedgeSegment Segment;
+	FVector ClosestPoint;
+	if (LedgeData.CoversWorld(GetWorld()) &&
+		LedgeData.FindNearestSegment(GetWorld(), HandLocation, ClimbValidationTolerance + ClimbArrowRadius, Segment, ClosestPoint))
+	{
+		return true;
+	}
+
+	const FVector StartTrace = HandLocation + FVector(0.0f, 0.0f, ClimbValidationTolerance);
+	const FVector EndTrace = HandLocation - FVector(0.0f, 0.0f, ClimbValidationTolerance);
+
+	FHitResult Hit;
+
+	if (LedgeSphereTrace(StartTrace, EndTrace, true, false, Hit))
+	{
+		return true;
+	}
+
+	INC_DWORD_STAT(STAT_ClimbValidationRejects);
+	return false;
+}
+
+void UClimbingComponent::ServerHandleGrab(const FVector& HeightLocation, const FVector& WallLocation, const FVector& WallNormal)
+{
+	if (bIsLedgeClimbing)
+	{
+		return;
+	}
+
+	FVector ValidHeight = HeightLocation;
+	FVector ValidWall = WallLocation;
+	FVector ValidNormal = WallNormal;
+	UPrimitiveComponent* Base = nullptr;
+	if (!ValidateLedgeGrab(ValidHeight, ValidWall, ValidNormal, Base))
+	{
+		CharacterOwner->ClientCorrectGrab(false, HeightLocation, WallLocation, WallNormal, nullptr);
+		return;
+	}
+
+	GrabLedge(ValidHeight, ValidWall, ValidNormal, Base);
+	if (!ValidHeight.Equals(HeightLocation, 1.0f) || !ValidWall.Equals(WallLocation, 1.0f) || !ValidNormal.Equals(WallNormal, 0.05f))
+	{
+		CharacterOwner->ClientCorrectGrab(true, ValidHeight, ValidWall, ValidNormal, Base);
+	}
+}
+
+void UClimbingComponent::ServerHandleShimmy(const FVector& NewLocation, bool bRight)
+{
+	// A rejected step is dropped, movement replication pulls the client back to the server position
+	float PaidUntil = 0.0f;
+	if (ValidateLedgeShimmy(NewLocation, bRight, PaidUntil))
+	{
+		ShimmyPaidUntil = PaidUntil;
+		LastShimmyStepTime = GetWorld()->GetTimeSeconds();
+		CharacterOwner->SetActorLocation(NewLocation);
+
+		// The server does not probe for a remote character, all it knows is that the ledge went on the way it moved
+		bMovingLedgeRight = bRight;
+		bMovingLedgeLeft = !bRight;
+		bCanLedgeMoveRight = bRight;
+		bCanLedgeMoveLeft = !bRight;
+		SyncAnimFlags();
+	}
+}
+
+void UClimbingComponent::ServerHandleClimb()
+{
+	if (bIsHanging)
+	{
+		ClimbLedgeEvent();
+	}
+}
+
+void UClimbingComponent::ApplyReplicatedClimbState(bool bHanging, bool bLedgeClimbing, bool bMovingRight, bool bMovingLeft)
+{
+	// The anim calls GrabLedge, ExitLedge and ClimbLedgeEvent make where the probes run
+	UObject* pointerToAnyUObject = CharacterOwner->GetMesh()->GetAnimInstance();
+	ILedgeClimbInterface* LedgeClimb = Cast<ILedgeClimbInterface>(pointerToAnyUObject);
+	if (LedgeClimb)
+	{
+		if (bLedgeClimbing && !bIsLedgeClimbing)
+		{
+			LedgeClimb->Execute_ClimbLedge(pointerToAnyUObject, true);
+		}
+		else if (bHanging != bIsHanging)
+		{
+			LedgeClimb->Execute_CanGrab(pointerToAnyUObject, bHanging);
+		}
+	}
+	bIsHanging = bHanging;
+	bIsLedgeClimbing = bLedgeClimbing;
+
+	// Only the shimmy direction is replicated, the ledge goes on at least the way the character moves
+	bMovingLedgeRight = bMovingRight;
+	bMovingLedgeLeft = bMovingLeft;
+	bCanLedgeMoveRight = bMovingRight;
+	bCanLedgeMoveLeft = bMovingLeft;
+	SyncAnimFlags();
+}
+
+void UClimbingComponent::ClientHandleCorrection(bool bAccepted, const FVector& HeightLocation, const FVector& WallLocation, const FVector& WallNormal, UPrimitiveComponent* Base)
+{
+	if (bAccepted)
+	{
+		// Bases this client cannot resolve arrive null, keep following the current one when the corrected ledge is on it
+		UPrimitiveComponent* CurrentBase = Ledge.Hanging.Base.Get();
+		if (!Base && CurrentBase && CurrentBase->Bounds.GetBox().ExpandBy(ClimbValidationTolerance).IsInside(HeightLocation))
+		{
+			Base = CurrentBase;
+		}
+		GrabLedge(HeightLocation, WallLocation, WallNormal, Base);
+	}
+	else
+	{
+		ExitLedge();
+	}
+}
+
+void UClimbingComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	SCOPE_CYCLE_COUNTER(STAT_ClimbingTick);
+
+	// Shimmy steps and exits apply at once, they are complete when a frame after that one ticks
+	for (int32 Action = 0; Action < (int32)EClimbAction::Count; ++Action)
+	{
+		if (ClimbTraceEffectFrames[Action] != 0 && GFrameCounter > ClimbTraceEffectFrames[Action])
+		{
+			ClimbTraceEffectFrames[Action] = 0;
+			MarkClimbTrace((EClimbAction)Action, EClimbStage::Complete);
+		}
+	}
+
+	UpdateGrabMove(DeltaTime);
+
+	bool bWallInReach = false;
+	if (ShouldRunLedgeProbes())
+	{
+		// A ledge on an unchanged base is still where it was relative to the capsule, however far the base moved
+		const bool bLedgeCurrent = bIsHanging && IsHangingLedgeCurrent();
+
+		// Coarse to fine: reach volume, then forward sweeps, then height sweeps, each stage gating the next
+		bWallInReach = bLedgeCurrent || ReachTracer();
+		if (bWallInReach && !bLedgeCurrent)
+		{
+			const bool bRightForward = ForwardTracer(1.0f, Ledge.Right);
+			const bool bLeftForward = ForwardTracer(-1.0f, Ledge.Left);
+			if (bRightForward)
+			{
+				HeightTracer(1.0f, Ledge.Right);
+			}
+			if (bLeftForward)
+			{
+				HeightTracer(-1.0f, Ledge.Left);
+			}
+		}
+		if (bIsHanging)
+		{
+			bCanLedgeMoveRight = SideTracer(1.0f);
+			bCanLedgeMoveLeft = SideTracer(-1.0f);
+			UpdateHopSearch();
+			SyncAnimFlags();
+		}
+	}
+
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		// Nothing releases a remote client's shimmy input here, it ends when its steps stop arriving
+		if (!ShouldRunLedgeProbes() && (bMovingLedgeRight || bMovingLedgeLeft) && GetWorld()->GetTimeSeconds() - LastShimmyStepTime > ShimmyStepTimeout)
+		{
+			bMovingLedgeRight = false;
+			bMovingLedgeLeft = false;
+			SyncAnimFlags();
+		}
+		CharacterOwner->SetReplicatedClimbState(bIsHanging, bIsLedgeClimbing, bMovingLedgeRight, bMovingLedgeLeft);
+	}
+
+	// Server validation since the last tick is counted here too
+	INC_DWORD_STAT_BY(STAT_ClimbSceneQueries, FrameSceneQueries);
+	LastFrameScenario = GetFrameScenario(bWallInReach);
+	LastFrameSceneQueries = FrameSceneQueries;
+	FClimbProbeBudget::Get().RecordFrame(LastFrameScenario, FrameSceneQueries);
+	FrameSceneQueries = 0;
+	ActionScenario = EClimbScenario::Count;
+}
+
+EClimbScenario UClimbingComponent::GetFrameScenario(bool bWallInReach) const
+{
+	if (ActionScenario != EClimbScenario::Count)
+	{
+		return ActionScenario;
+	}
+	if (bIsLedgeClimbing)
+	{
+		return EClimbScenario::ClimbUp;
+	}
+	if (bIsHanging)
+	{
+		return bMovingLedgeRight || bMovingLedgeLeft ? EClimbScenario::Shimmy : EClimbScenario::Hanging;
+	}
+	return bWallInReach ? EClimbScenario::AlongWall : EClimbScenario::Idle;
+}
@@ -0,0 +1,608 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "LedgeData.h"
+#include "Movement.h"
+#include "Async/MappedFileHandle.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/Level.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "PhysicsEngine/BodySetup.h"
+
+//////////////////////////////////////////////////////////////////////////
+// FLedgeDataView
+
+FLedgeDataView::FLedgeDataView()
+	: Header(nullptr)
+	, CellStarts(nullptr)
+	, Segments(nullptr)
+	, UnbakedBounds(nullptr)
+{
+}
+
+bool FLedgeDataView::Initialize(const uint8* Data, int64 Size)
+{
+	Header = nullptr;
+	if (!Data || Size < (int64)sizeof(FLedgeDataHeader))
+	{
+		return false;
+	}
+
+	const FLedgeDataHeader* Candidate = reinterpret_cast<const FLedgeDataHeader*>(Data);
+	if (Candidate->Magic != FLedgeDataHeader::ExpectedMagic || Candidate->Version != FLedgeDataHeader::ExpectedVersion ||
+		Candidate->CellsX <= 0 || Candidate->CellsY <= 0 || Candidate->CellSize <= 0.0f)
+	{
+		return false;
+	}
+
+	const int64 NumCells = (int64)Candidate->CellsX * Candidate->CellsY;
+	const int64 ExpectedSize = sizeof(FLedgeDataHeader) + (NumCells + 1) * sizeof(uint32) + (int64)Candidate->NumSegments * sizeof(FLedgeSegment) +
+		(int64)Candidate->NumUnbakedBounds * sizeof(FLedgeDataBounds);
+	if (Size < ExpectedSize)
+	{
+		return false;
+	}
+
+	const uint32* Starts = reinterpret_cast<const uint32*>(Data + sizeof(FLedgeDataHeader));
+	if (Starts[NumCells] != Candidate->NumSegments)
+	{
+		return false;
+	}
+
+	Header = Candidate;
+	CellStarts = Starts;
+	Segments = reinterpret_cast<const FLedgeSegment*>(Starts + NumCells + 1);
+	UnbakedBounds = reinterpret_cast<const FLedgeDataBounds*>(Segments + Candidate->NumSegments);
+	return true;
+}
+
+bool FLedgeDataView::AnySegmentInBox(const FBox& Box) const
+{
+	bool bFound = false;
+	ForEachSegmentNear(Box, [&](const FLedgeSegment& Segment)
+	{
+		if (!bFound && (Box.IsInside(Segment.Start) || FMath::LineBoxIntersection(Box, Segment.Start, Segment.End, Segment.End - Segment.Start)))
+		{
+			bFound = true;
+		}
+	});
+	return bFound;
+}
+
+const FLedgeSegment* FLedgeDataView::FindNearestSegment(const FVector& Location, float MaxDistance, FVector& OutClosestPoint) const
+{
+	const FLedgeSegment* Nearest = nullptr;
+	float NearestDistSquared = FMath::Square(MaxDistance);
+	ForEachSegmentNear(FBox::BuildAABB(Location, FVector(MaxDistance)), [&](const FLedgeSegment& Segment)
+	{
+		const FVector Closest = Segment.GetClosestPoint(Location);
+		const float DistSquared = FVector::DistSquared(Closest, Location);
+		if (DistSquared <= NearestDistSquared)
+		{
+			NearestDistSquared = DistSquared;
+			Nearest = &Segment;
+			OutClosestPoint = Closest;
+		}
+	});
+	return Nearest;
+}
+
+bool FLedgeDataView::AnyUnbakedInBox(const FBox& Box) const
+{
+	if (!Header)
+	{
+		return false;
+	}
+	// Levels are expected to be mostly boxes, so the few leftovers are not worth a grid
+	for (uint32 Index = 0; Index < Header->NumUnbakedBounds; ++Index)
+	{
+		if (Box.Intersect(FBox(UnbakedBounds[Index].Min, UnbakedBounds[Index].Max)))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FLedgeDataBuilder
+
+/** Directory baked files are read from and written to when not empty, set by tests */
+static FString LedgeDataDirectoryOverride;
+
+/** Local box of a primitive whose collision is a single axis aligned box, false for any other shape */
+static bool GetCollisionBox(const UPrimitiveComponent* Primitive, FBox& OutLocalBox)
+{
+	UBodySetup* BodySetup = const_cast<UPrimitiveComponent*>(Primitive)->GetBodySetup();
+	if (!BodySetup || BodySetup->GetCollisionTraceFlag() == CTF_UseComplexAsSimple ||
+		BodySetup->AggGeom.GetElementCount() != 1 || BodySetup->AggGeom.BoxElems.Num() != 1)
+	{
+		return false;
+	}
+
+	const FKBoxElem& Box = BodySetup->AggGeom.BoxElems[0];
+	if (!Box.Rotation.IsNearlyZero())
+	{
+		return false;
+	}
+	OutLocalBox = FBox::BuildAABB(Box.Center, FVector(Box.X, Box.Y, Box.Z) * 0.5f);
+	return true;
+}
+
+void FLedgeDataBuilder::GatherSegments(const ULevel* Level, TArray<FLedgeSegment>& OutSegments, TArray<FBox>& OutUnbakedBounds)
+{
+	const ECollisionChannel LedgeChannel = UEngineTypes::ConvertToCollisionChannel(ETraceTypeQuery::TraceTypeQuery3);
+
+	for (const AActor* Actor : Level->Actors)
+	{
+		if (!Actor)
+		{
+			continue;
+		}
+
+		TInlineComponentArray<UPrimitiveComponent*> Primitives(Actor);
+		for (const UPrimitiveComponent* Primitive : Primitives)
+		{
+			if (!Primitive->IsCollisionEnabled() || Primitive->GetCollisionResponseToChannel(LedgeChannel) != ECR_Block)
+			{
+				continue;
+			}
+
+			// Anything that can move is only ever found by physics queries
+			if (Primitive->Mobility != EComponentMobility::Static)
+			{
+				continue;
+			}
+
+			// Only upright boxes have edges that are known exactly, the rest stay with physics
+			const FTransform& Transform = Primitive->GetComponentTransform();
+			FBox LocalBox;
+			if (Transform.GetUnitAxis(EAxis::Z).Z < 0.9f || !GetCollisionBox(Primitive, LocalBox))
+			{
+				OutUnbakedBounds.Add(Primitive->Bounds.GetBox());
+				continue;
+			}
+
+			const FVector Corners[4] =
+			{
+				FVector(LocalBox.Min.X, LocalBox.Min.Y, LocalBox.Max.Z),
+				FVector(LocalBox.Max.X, LocalBox.Min.Y, LocalBox.Max.Z),
+				FVector(LocalBox.Max.X, LocalBox.Max.Y, LocalBox.Max.Z),
+				FVector(LocalBox.Min.X, LocalBox.Max.Y, LocalBox.Max.Z),
+			};
+			const FVector Normals[4] = { FVector(0, -1, 0), FVector(1, 0, 0), FVector(0, 1, 0), FVector(-1, 0, 0) };
+
+			for (int32 Edge = 0; Edge < 4; ++Edge)
+			{
+				FLedgeSegment Segment;
+				Segment.Start = Transform.TransformPosition(Corners[Edge]);
+				Segment.End = Transform.TransformPosition(Corners[(Edge + 1) % 4]);
+				Segment.WallNormal = Transform.TransformVectorNoScale(Normals[Edge]).GetSafeNormal2D();
+				OutSegments.Add(Segment);
+			}
+		}
+	}
+}
+
+void FLedgeDataBuilder::Serialize(const TArray<FLedgeSegment>& Segments, const TArray<FBox>& UnbakedBounds, float CellSize, TArray<uint8>& OutData)
+{
+	FBox Bounds(ForceInit);
+	float MaxHalfLength = 0.0f;
+	for (const FLedgeSegment& Segment : Segments)
+	{
+		Bounds += (Segment.Start + Segment.End) * 0.5f;
+		MaxHalfLength = FMath::Max(MaxHalfLength, FVector::Dist(Segment.Start, Segment.End) * 0.5f);
+	}
+	if (!Bounds.IsValid)
+	{
+		Bounds = FBox(FVector::ZeroVector, FVector::ZeroVector);
+	}
+
+	FLedgeDataHeader Header;
+	Header.Magic = FLedgeDataHeader::ExpectedMagic;
+	Header.Version = FLedgeDataHeader::ExpectedVersion;
+	Header.Origin = Bounds.Min;
+	Header.CellSize = CellSize;
+	Header.CellsX = FMath::Max(1, FMath::CeilToInt((Bounds.Max.X - Bounds.Min.X) / CellSize) + 1);
+	Header.CellsY = FMath::Max(1, FMath::CeilToInt((Bounds.Max.Y - Bounds.Min.Y) / CellSize) + 1);
+	Header.MaxHalfLength = MaxHalfLength;
+	Header.NumSegments = Segments.Num();
+	Header.NumUnbakedBounds = UnbakedBounds.Num();
+
+	auto CellOf = [&Header](const FLedgeSegment& Segment)
+	{
+		const FVector Mid = (Segment.Start + Segment.End) * 0.5f;
+		const int32 X = FMath::Clamp(FMath::FloorToInt((Mid.X - Header.Origin.X) / Header.CellSize), 0, Header.CellsX - 1);
+		const int32 Y = FMath::Clamp(FMath::FloorToInt((Mid.Y - Header.Origin.Y) / Header.CellSize), 0, Header.CellsY - 1);
+		return Y * Header.CellsX + X;
+	};
+
+	const int32 NumCells = Header.CellsX * Header.CellsY;
+	TArray<uint32> CellStarts;
+	CellStarts.SetNumZeroed(NumCells + 1);
+	for (const FLedgeSegment& Segment : Segments)
+	{
+		++CellStarts[CellOf(Segment) + 1];
+	}
+	for (int32 Cell = 0; Cell < NumCells; ++Cell)
+	{
+		CellStarts[Cell + 1] += CellStarts[Cell];
+	}
+
+	TArray<FLedgeSegment> Sorted;
+	Sorted.SetNumUninitialized(Segments.Num());
+	TArray<uint32> Cursor(CellStarts);
+	for (const FLedgeSegment& Segment : Segments)
+	{
+		Sorted[Cursor[CellOf(Segment)]++] = Segment;
+	}
+
+	OutData.Reset();
+	OutData.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+	OutData.Append(reinterpret_cast<const uint8*>(CellStarts.GetData()), CellStarts.Num() * sizeof(uint32));
+	OutData.Append(reinterpret_cast<const uint8*>(Sorted.GetData()), Sorted.Num() * sizeof(FLedgeSegment));
+	for (const FBox& Box : UnbakedBounds)
+	{
+		const FLedgeDataBounds Bounds = { Box.Min, Box.Max };
+		OutData.Append(reinterpret_cast<const uint8*>(&Bounds), sizeof(Bounds));
+	}
+}
+
+FString FLedgeDataBuilder::GetLedgeDataFilename(const ULevel* Level)
+{
+	const FString PackageName = UWorld::RemovePIEPrefix(Level->GetOutermost()->GetName());
+	return GetDataDirectory() / FPackageName::GetShortName(PackageName) + TEXT(".ledges");
+}
+
+FString FLedgeDataBuilder::GetDataDirectory()
+{
+	return LedgeDataDirectoryOverride.IsEmpty() ? FPaths::ProjectContentDir() / TEXT("LedgeData") : LedgeDataDirectoryOverride;
+}
+
+void FLedgeDataBuilder::SetDataDirectoryOverride(const FString& Directory)
+{
+	LedgeDataDirectoryOverride = Directory;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// FLedgeDataRegistry
+
+FLedgeDataRegistry::FEntry::FEntry()
+	: Handle(nullptr)
+	, Region(nullptr)
+	, FieldHandle(nullptr)
+	, FieldRegion(nullptr)
+	, LoadSeconds(0.0)
+	, MappedBytes(0)
+{
+}
+
+FLedgeDataRegistry::FEntry::~FEntry()
+{
+	DEC_MEMORY_STAT_BY(STAT_LedgeDataMappedMemory, MappedBytes);
+	delete Region;
+	delete Handle;
+	delete FieldRegion;
+	delete FieldHandle;
+}
+
+FLedgeDataRegistry& FLedgeDataRegistry::Get()
+{
+	static FLedgeDataRegistry Registry;
+	return Registry;
+}
+
+void FLedgeDataRegistry::Startup()
+{
+	PostWorldInitHandle = FWorldDelegates::OnPostWorldInitialization.AddRaw(this, &FLedgeDataRegistry::OnPostWorldInitialization);
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FLedgeDataRegistry::OnLevelAdded);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FLedgeDataRegistry::OnLevelRemoved);
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FLedgeDataRegistry::OnWorldCleanup);
+}
+
+void FLedgeDataRegistry::Shutdown()
+{
+	FWorldDelegates::OnPostWorldInitialization.Remove(PostWorldInitHandle);
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+	Entries.Empty();
+}
+
+void FLedgeDataRegistry::RegisterLevel(ULevel* Level)
+{
+	if (!Level || Entries.Contains(Level))
+	{
+		return;
+	}
+
+	const FString Filename = FLedgeDataBuilder::GetLedgeDataFilename(Level);
+	const FString FieldFilename = FClimbFieldBuilder::GetClimbFieldFilename(Level);
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Levels without baked data fall back to physics queries
+	TUniquePtr<FEntry> Entry = MakeUnique<FEntry>();
+	Entry->Level = Level;
+	Entry->Filename = Filename;
+	if (MapFile(Filename, Entry->Handle, Entry->Region) &&
+		!Entry->View.Initialize(Entry->Region->GetMappedPtr(), Entry->Region->GetMappedSize()))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Ignoring invalid ledge data %s"), *Filename);
+	}
+	if (MapFile(FieldFilename, Entry->FieldHandle, Entry->FieldRegion) &&
+		!Entry->Field.Initialize(Entry->FieldRegion->GetMappedPtr(), Entry->FieldRegion->GetMappedSize()))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Ignoring invalid climb field %s"), *FieldFilename);
+	}
+	if (!Entry->View.IsValid() && !Entry->Field.IsValid())
+	{
+		return;
+	}
+
+	Entry->MappedBytes = (Entry->Region ? Entry->Region->GetMappedSize() : 0) + (Entry->FieldRegion ? Entry->FieldRegion->GetMappedSize() : 0);
+	Entry->LoadSeconds = FPlatformTime::Seconds() - StartTime;
+	INC_MEMORY_STAT_BY(STAT_LedgeDataMappedMemory, Entry->MappedBytes);
+
+	UE_LOG(LogTemp, Log, TEXT("Mapped ledge data %s: %d segments, %d field bricks, %lld bytes, %.3f ms"),
+		*Filename, Entry->View.Num(), Entry->Field.NumBricks(), Entry->MappedBytes, Entry->LoadSeconds * 1000.0);
+	Entries.Add(Level, MoveTemp(Entry));
+}
+
+bool FLedgeDataRegistry::MapFile(const FString& Filename, IMappedFileHandle*& OutHandle, IMappedFileRegion*& OutRegion)
+{
+	OutHandle = FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename);
+	if (!OutHandle)
+	{
+		return false;
+	}
+	OutRegion = OutHandle->MapRegion(0, OutHandle->GetFileSize());
+	if (!OutRegion)
+	{
+		delete OutHandle;
+		OutHandle = nullptr;
+		return false;
+	}
+	return true;
+}
+
+void FLedgeDataRegistry::UnregisterLevel(ULevel* Level)
+{
+	Entries.Remove(Level);
+}
+
+void FLedgeDataRegistry::UnregisterWorld(UWorld* World)
+{
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		const ULevel* Level = It.Value()->Level.Get();
+		if (!Level || Level->OwningWorld == World)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool FLedgeDataRegistry::CoversWorld(const UWorld* World) const
+{
+	if (!World || Entries.Num() == 0)
+	{
+		return false;
+	}
+	for (const ULevel* Level : World->GetLevels())
+	{
+		if (!Level || !Level->bIsVisible)
+		{
+			continue;
+		}
+		const TUniquePtr<FEntry>* Entry = Entries.Find(Level);
+		if (!Entry || !(*Entry)->View.IsValid())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FLedgeDataRegistry::FieldCoversWorld(const UWorld* World) const
+{
+	if (!World || Entries.Num() == 0)
+	{
+		return false;
+	}
+	for (const ULevel* Level : World->GetLevels())
+	{
+		if (!Level || !Level->bIsVisible)
+		{
+			continue;
+		}
+		const TUniquePtr<FEntry>* Entry = Entries.Find(Level);
+		if (!Entry || !(*Entry)->Field.IsValid())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FLedgeDataRegistry::SampleClimbField(const UWorld* World, const FVector& Location, FClimbSurfaceSample& OutSample) const
+{
+	bool bFound = false;
+	for (const auto& Pair : Entries)
+	{
+		const ULevel* Level = Pair.Value->Level.Get();
+		if (!Level || Level->OwningWorld != World)
+		{
+			continue;
+		}
+
+		// Where level fields overlap the nearest surface wins
+		FClimbSurfaceSample Sample;
+		if (Pair.Value->Field.Sample(Location, Sample) && (!bFound || Sample.Distance < OutSample.Distance))
+		{
+			OutSample = Sample;
+			bFound = true;
+		}
+	}
+	return bFound;
+}
+
+bool FLedgeDataRegistry::AnySegmentInBox(const UWorld* World, const FBox& Box) const
+{
+	for (const auto& Pair : Entries)
+	{
+		const ULevel* Level = Pair.Value->Level.Get();
+		if (Level && Level->OwningWorld == World && Pair.Value->View.AnySegmentInBox(Box))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FLedgeDataRegistry::AnyUnbakedInBox(const UWorld* World, const FBox& Box) const
+{
+	for (const auto& Pair : Entries)
+	{
+		const ULevel* Level = Pair.Value->Level.Get();
+		if (Level && Level->OwningWorld == World && Pair.Value->View.AnyUnbakedInBox(Box))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FLedgeDataRegistry::FindNearestSegment(const UWorld* World, const FVector& Location, float MaxDistance, FLedgeSegment& OutSegment, FVector& OutClosestPoint) const
+{
+	bool bFound = false;
+	for (const auto& Pair : Entries)
+	{
+		const ULevel* Level = Pair.Value->Level.Get();
+		if (!Level || Level->OwningWorld != World)
+		{
+			continue;
+		}
+
+		FVector Closest;
+		if (const FLedgeSegment* Segment = Pair.Value->View.FindNearestSegment(Location, MaxDistance, Closest))
+		{
+			// Later levels only win if they are closer
+			MaxDistance = FVector::Dist(Closest, Location);
+			OutSegment = *Segment;
+			OutClosestPoint = Closest;
+			bFound = true;
+		}
+	}
+	return bFound;
+}
+
+bool FLedgeDataRegistry::GetLevelStats(const ULevel* Level, double& OutLoadSeconds, int64& OutMappedBytes) const
+{
+	const TUniquePtr<FEntry>* Entry = Entries.Find(Level);
+	if (!Entry)
+	{
+		return false;
+	}
+	OutLoadSeconds = (*Entry)->LoadSeconds;
+	OutMappedBytes = (*Entry)->MappedBytes;
+	return true;
+}
+
+void FLedgeDataRegistry::DumpStats() const
+{
+	int64 TotalBytes = 0;
+	for (const auto& Pair : Entries)
+	{
+		const FEntry& Entry = *Pair.Value;
+		UE_LOG(LogTemp, Display, TEXT("%s: %d segments, %d field bricks, %lld bytes mapped, %.3f ms to load"),
+			*FPaths::GetBaseFilename(Entry.Filename), Entry.View.Num(), Entry.Field.NumBricks(), Entry.MappedBytes, Entry.LoadSeconds * 1000.0);
+		TotalBytes += Entry.MappedBytes;
+	}
+	UE_LOG(LogTemp, Display, TEXT("%d levels with ledge data, %lld bytes mapped"), Entries.Num(), TotalBytes);
+}
+
+void FLedgeDataRegistry::OnPostWorldInitialization(UWorld* World, const UWorld::InitializationValues IVS)
+{
+	if (World && World->IsGameWorld())
+	{
+		RegisterLevel(World->PersistentLevel);
+	}
+}
+
+void FLedgeDataRegistry::OnLevelAdded(ULevel* Level, UWorld* World)
+{
+	if (World && World->IsGameWorld())
+	{
+		RegisterLevel(Level);
+	}
+}
+
+void FLedgeDataRegistry::OnLevelRemoved(ULevel* Level, UWorld* World)
+{
+	// A null level means every level of the world is going away
+	if (Level)
+	{
+		UnregisterLevel(Level);
+	}
+	else
+	{
+		UnregisterWorld(World);
+	}
+}
+
+void FLedgeDataRegistry::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	UnregisterWorld(World);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Console commands
+
+// Climb field resolution, and how far from climbable geometry it is baked, a little past the forward probes' reach
+static const float ClimbFieldVoxelSize = 25.0f;
+static const float ClimbFieldBand = 175.0f;
+
+static FAutoConsoleCommandWithWorld BakeLedgeDataCommand(
+	TEXT("Climbing.BakeLedgeData"),
+	TEXT("Writes Content/LedgeData/<Level>.ledges and <Level>.climbfield for every loaded level and maps the result"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		for (ULevel* Level : World->GetLevels())
+		{
+			TArray<FLedgeSegment> Segments;
+			TArray<FBox> UnbakedBounds;
+			FLedgeDataBuilder::GatherSegments(Level, Segments, UnbakedBounds);
+
+			TArray<uint8> Data;
+			FLedgeDataBuilder::Serialize(Segments, UnbakedBounds, 1000.0f, Data);
+
+			TArray<uint8> FieldData;
+			FClimbFieldBuilder::Bake(Level, Segments, ClimbFieldVoxelSize, ClimbFieldBand, FieldData);
+
+			// Drop the old mappings before overwriting the files
+			FLedgeDataRegistry::Get().UnregisterLevel(Level);
+			const FString Filename = FLedgeDataBuilder::GetLedgeDataFilename(Level);
+			const FString FieldFilename = FClimbFieldBuilder::GetClimbFieldFilename(Level);
+			if (FFileHelper::SaveArrayToFile(Data, *Filename))
+			{
+				UE_LOG(LogTemp, Display, TEXT("Baked %d ledge segments to %s, %d primitives left to physics"), Segments.Num(), *Filename, UnbakedBounds.Num());
+			}
+			if (FFileHelper::SaveArrayToFile(FieldData, *FieldFilename))
+			{
+				UE_LOG(LogTemp, Display, TEXT("Baked %lld bytes of climb field to %s"), (int64)FieldData.Num(), *FieldFilename);
+			}
+			FLedgeDataRegistry::Get().RegisterLevel(Level);
+		}
+	}));
+
+static FAutoConsoleCommand LedgeDataStatsCommand(
+	TEXT("Climbing.LedgeDataStats"),
+	TEXT("Logs load time and mapped memory of the ledge data of each loaded level"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FLedgeDataRegistry::Get().DumpStats();
+	}));
@@ -0,0 +1,190 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "LedgeHopSearch.h"
+#include "Movement.h"
+#include "LedgeData.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Actor.h"
+#include "Kismet/KismetSystemLibrary.h"
+
+// How far past the edge the probes land on a ledge top, the same inset the height probes have at hang distance
+static const float HopLedgeInset = 28.0f;
+
+// Sideways at the same height, up and diagonal, relative to the edge under the hands
+static const FVector HopOffsets[FLedgeHopSearch::NumCandidates] =
+{
+	FVector(HopLedgeInset, 150.0f, 0.0f),
+	FVector(HopLedgeInset, -150.0f, 0.0f),
+	FVector(HopLedgeInset, 250.0f, 0.0f),
+	FVector(HopLedgeInset, -250.0f, 0.0f),
+	FVector(HopLedgeInset, 0.0f, 120.0f),
+	FVector(HopLedgeInset, 150.0f, 120.0f),
+	FVector(HopLedgeInset, -150.0f, 120.0f),
+};
+
+// Longest hop in the wall plane, used to normalize hop distance
+static const float MaxHopDistance = 260.0f;
+
+// Vertical extent searched around each offset for a ledge top, same height and up candidates meet halfway
+static const float HopProbeHalfHeight = 60.0f;
+
+// Candidates whose wall turns further than this away from the current one are not hoppable
+static const float MinWallAlignment = 0.7f;
+
+// A ledge on the hanging base within this height of the hands is the one being hung from
+static const float SameLedgeHeightTolerance = 20.0f;
+
+FVector FLedgeHopCandidate::GetLedgeLocation() const
+{
+	const UPrimitiveComponent* Primitive = Base.Get();
+	return Primitive ? Primitive->GetComponentTransform().TransformPosition(LedgeLocation) : LedgeLocation;
+}
+
+FVector FLedgeHopCandidate::GetWallNormal() const
+{
+	const UPrimitiveComponent* Primitive = Base.Get();
+	return Primitive ? Primitive->GetComponentTransform().TransformVectorNoScale(WallNormal) : WallNormal;
+}
+
+FLedgeHopSearch::FLedgeHopSearch()
+{
+	for (int32 Index = 0; Index < NumCandidates; ++Index)
+	{
+		Candidates[Index].LocalOffset = HopOffsets[Index];
+		Candidates[Index].Hop = HopOffsets[Index];
+	}
+	Reset();
+}
+
+void FLedgeHopSearch::Reset()
+{
+	for (FLedgeHopCandidate& Candidate : Candidates)
+	{
+		Candidate.bValid = false;
+		Candidate.Base = nullptr;
+		Candidate.Score = 0.0f;
+	}
+	NextCandidate = 0;
+	BestCandidate = INDEX_NONE;
+	SceneQueriesLastUpdate = 0;
+}
+
+void FLedgeHopSearch::Update(const AActor* Owner, const FVector& HandOffset, const UPrimitiveComponent* HangBase, const FVector2D& Input, float TraceRadius, int32 Budget)
+{
+	const int32 Count = FMath::Clamp(Budget, 0, NumCandidates);
+	SceneQueriesLastUpdate = 0;
+	for (int32 Step = 0; Step < Count; ++Step)
+	{
+		SceneQueriesLastUpdate += Evaluate(Owner, HandOffset, HangBase, Candidates[NextCandidate], TraceRadius);
+		NextCandidate = (NextCandidate + 1) % NumCandidates;
+	}
+	INC_DWORD_STAT_BY(STAT_ClimbHopCandidates, Count);
+
+	// Scoring is cheap, so every candidate is rescored against the current input each frame, from where its ledge is now
+	const FVector2D InputDirection = Input.GetSafeNormal();
+	const FVector WallDirection = -Owner->GetActorForwardVector();
+	const FRotator Rotation = Owner->GetActorRotation();
+	const FVector HandLocation = Owner->GetActorLocation() + Rotation.RotateVector(HandOffset);
+
+	BestCandidate = INDEX_NONE;
+	float BestScore = -MAX_FLT;
+	for (int32 Index = 0; Index < NumCandidates; ++Index)
+	{
+		FLedgeHopCandidate& Candidate = Candidates[Index];
+		if (!Candidate.bValid)
+		{
+			continue;
+		}
+
+		Candidate.Hop = Rotation.UnrotateVector(Candidate.GetLedgeLocation() - HandLocation);
+		const FVector2D Hop(Candidate.Hop.Y, Candidate.Hop.Z);
+		const float Alignment = FVector2D::DotProduct(Hop.GetSafeNormal(), InputDirection);
+		const float Feasibility = 1.0f - FMath::Min(Hop.Size() / MaxHopDistance, 1.0f);
+
+		// Only baked ledges know their wall, a swept one is neither favoured nor penalized for it
+		const FVector WallNormal = Candidate.GetWallNormal();
+		const float WallTurn = WallNormal.IsZero() ? 0.0f : 1.0f - FVector::DotProduct(WallNormal, WallDirection);
+
+		// Input direction dominates, shorter hops onto a parallel wall break ties
+		Candidate.Score = 2.0f * Alignment + Feasibility - 0.5f * WallTurn;
+		if (Candidate.Score > BestScore)
+		{
+			BestScore = Candidate.Score;
+			BestCandidate = Index;
+		}
+	}
+}
+
+const FLedgeHopCandidate* FLedgeHopSearch::GetBest() const
+{
+	return BestCandidate != INDEX_NONE ? &Candidates[BestCandidate] : nullptr;
+}
+
+bool FLedgeHopSearch::HasTargetToSide(float Direction) const
+{
+	for (const FLedgeHopCandidate& Candidate : Candidates)
+	{
+		if (Candidate.bValid && Candidate.Hop.Y * Direction > 0.0f)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+int32 FLedgeHopSearch::Evaluate(const AActor* Owner, const FVector& HandOffset, const UPrimitiveComponent* HangBase, FLedgeHopCandidate& Candidate, float TraceRadius) const
+{
+	const FVector HandLocation = Owner->GetActorLocation() + Owner->GetActorRotation().RotateVector(HandOffset);
+	const FVector ProbeLocation = Owner->GetActorLocation() + Owner->GetActorRotation().RotateVector(HandOffset + Candidate.LocalOffset);
+	const FVector WallDirection = -Owner->GetActorForwardVector();
+	Candidate.bValid = false;
+	Candidate.Base = nullptr;
+
+	UWorld* World = Owner->GetWorld();
+	const FLedgeDataRegistry& LedgeData = FLedgeDataRegistry::Get();
+	if (LedgeData.CoversWorld(World))
+	{
+		// The edge is HopLedgeInset behind the probe, and anywhere within the probe's vertical extent
+		const float SearchRadius = FVector2D(HopLedgeInset + TraceRadius, HopProbeHalfHeight).Size();
+		FLedgeSegment Segment;
+		FVector ClosestPoint;
+		if (LedgeData.FindNearestSegment(World, ProbeLocation, SearchRadius, Segment, ClosestPoint) &&
+			FMath::Abs(ClosestPoint.Z - ProbeLocation.Z) <= HopProbeHalfHeight)
+		{
+			// The segment under the hands is the ledge being hung from, not somewhere to hop to
+			FLedgeSegment HandSegment;
+			FVector HandClosestPoint;
+			const bool bHangingFrom = LedgeData.FindNearestSegment(World, HandLocation, HopLedgeInset, HandSegment, HandClosestPoint) &&
+				HandSegment.Start.Equals(Segment.Start) && HandSegment.End.Equals(Segment.End);
+
+			Candidate.LedgeLocation = ClosestPoint;
+			Candidate.WallNormal = Segment.WallNormal;
+			Candidate.bValid = !bHangingFrom && FVector::DotProduct(Segment.WallNormal, WallDirection) > MinWallAlignment;
+			return 0;
+		}
+		// Movable and unbaked geometry is only known to physics
+	}
+
+	// Start a sphere radius above the searched extent so a ledge at its top is not already penetrated
+	const FVector StartTrace = ProbeLocation + FVector(0.0f, 0.0f, HopProbeHalfHeight + TraceRadius);
+	const FVector EndTrace = ProbeLocation - FVector(0.0f, 0.0f, HopProbeHalfHeight);
+	TArray<AActor*> ActorsToIgnore;
+	ActorsToIgnore.Add(const_cast<AActor*>(Owner));
+
+	FHitResult Hit;
+
+	if (UKismetSystemLibrary::SphereTraceSingle(World, StartTrace, EndTrace, TraceRadius, ETraceTypeQuery::TraceTypeQuery3,
+		false, ActorsToIgnore, EDrawDebugTrace::ForOneFrame, Hit, true) &&
+		!Hit.bStartPenetrating && Hit.ImpactNormal.Z > 0.7f)
+	{
+		// A sweep down only finds the top, so the wall under it stays unknown
+		UPrimitiveComponent* Primitive = Hit.GetComponent();
+		Candidate.Base = Primitive;
+		Candidate.LedgeLocation = Primitive ? Primitive->GetComponentTransform().InverseTransformPosition(Hit.ImpactPoint) : Hit.ImpactPoint;
+		Candidate.WallNormal = FVector::ZeroVector;
+
+		// The top of the hanging base level with the hands is the ledge being hung from
+		Candidate.bValid = !(Primitive && Primitive == HangBase && FMath::Abs(Hit.ImpactPoint.Z - HandLocation.Z) <= SameLedgeHeightTolerance);
+	}
+	return 1;
+}
@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbingComponent.h"
+#include "ClimbingTestLevel.h"
+#include "MovementCharacter.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ClimbMovingLedgeTest
+{
+	// The player character, its anim blueprint implements the ledge climb interface grabbing needs
+	static const TCHAR* CharacterClassPath = TEXT("/Game/ThirdPersonCPP/Blueprints/ThirdPersonCharacter.ThirdPersonCharacter_C");
+
+	// Where the character starts, facing +X, and how far in front of it the platform's face is
+	static const FVector LedgeLocation(0.0f, 0.0f, 200.0f);
+	static const float WallDistance = 100.0f;
+
+	// How far above the pelvis the ledge top is put, HeightTracer wants it within 50
+	static const float LedgeAbovePelvis = 25.0f;
+
+	// How far the platform moves each frame, along the wall and upwards
+	static const FVector PlatformStep(0.0f, 3.0f, 1.0f);
+
+	// Side tracers, one query each
+	static const int32 SideTracerQueries = 2;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbMovingLedgeTest, "Movement.Climbing.MovingLedge",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FClimbMovingLedgeTest::RunTest(const FString& Parameters)
+{
+	using namespace ClimbMovingLedgeTest;
+
+	UClass* CharacterClass = LoadClass<AMovementCharacter>(nullptr, CharacterClassPath);
+	if (!TestNotNull(TEXT("Player character blueprint loads"), CharacterClass))
+	{
+		return false;
+	}
+
+	FClimbingTestLevel TestLevel;
+	TestLevel.AddFloor(0.0f);
+
+	// Uncontrolled and not walking, but with movement running so based movement carries the capsule along
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AMovementCharacter* Character = TestLevel.GetWorld()->SpawnActor<AMovementCharacter>(CharacterClass, LedgeLocation, FRotator::ZeroRotator, SpawnParams);
+	Character->GetCharacterMovement()->bRunPhysicsWithNoController = true;
+	Character->GetCharacterMovement()->SetMovementMode(MOVE_Flying);
+	Character->EnableClimbing();
+	UClimbingComponent* Climbing = Character->GetClimbing();
+	TestLevel.Tick();
+
+	const float LedgeTop = Character->GetMesh()->GetSocketLocation(TEXT("PelvisSocket")).Z + LedgeAbovePelvis;
+	AActor* Platform = TestLevel.AddBlock(FVector(LedgeLocation.X + WallDistance + 100.0f, LedgeLocation.Y, LedgeTop),
+		FVector(100.0f, 300.0f, 150.0f), true, true);
+
+	for (int32 Frame = 0; Frame < 10 && !Climbing->IsHanging(); ++Frame)
+	{
+		TestLevel.Tick();
+	}
+	if (!TestTrue(TEXT("Grabbed the platform's ledge"), Climbing->IsHanging()))
+	{
+		return false;
+	}
+
+	// Long enough for the grab move to finish
+	TestLevel.Tick(30);
+	const FVector HangLocation = Platform->GetActorTransform().InverseTransformPosition(Character->GetActorLocation());
+
+	const int32 MaxHangingQueries = SideTracerQueries + Climbing->HopCandidatesPerFrame;
+	int32 FramesFollowed = 0;
+	int32 FramesUnprobed = 0;
+	static const int32 NumFrames = 60;
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		Platform->SetActorLocation(Platform->GetActorLocation() + PlatformStep);
+		TestLevel.Tick();
+
+		const FVector Expected = Platform->GetActorTransform().TransformPosition(HangLocation);
+		if (Character->GetActorLocation().Equals(Expected, 1.0f))
+		{
+			++FramesFollowed;
+		}
+
+		// Probing the ledge again would add the reach, forward and height queries on top of these
+		if (Climbing->GetLastFrameScenario() == EClimbScenario::Hanging && Climbing->GetLastFrameSceneQueries() <= MaxHangingQueries)
+		{
+			++FramesUnprobed;
+		}
+	}
+
+	TestTrue(TEXT("Still hanging"), Climbing->IsHanging());
+	TestEqual(TEXT("Capsule followed the platform every frame"), FramesFollowed, NumFrames);
+	TestEqual(FString::Printf(TEXT("Every frame within the hanging query count of %d"), MaxHangingQueries), FramesUnprobed, NumFrames);
+	return true;
+}
+
+#endif
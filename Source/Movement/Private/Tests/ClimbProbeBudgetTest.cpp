@@ -0,0 +1,160 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbProbeBudget.h"
+#include "ClimbingComponent.h"
+#include "ClimbingTestLevel.h"
+#include "MovementCharacter.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ClimbProbeBudgetTest
+{
+	// The player character, its anim blueprint implements the ledge climb interface grabbing needs
+	static const TCHAR* CharacterClassPath = TEXT("/Game/ThirdPersonCPP/Blueprints/ThirdPersonCharacter.ThirdPersonCharacter_C");
+
+	// Where the character starts each scenario, facing +X
+	static const FVector IdleLocation(0.0f, 3000.0f, 200.0f);
+	static const FVector WallLocation(0.0f, 1100.0f, 200.0f);
+	static const FVector LedgeLocation(0.0f, 0.0f, 200.0f);
+
+	// Every wall's face is this far in front of the character
+	static const float WallDistance = 100.0f;
+
+	// How far above the pelvis a grabbable ledge top is put, HeightTracer wants it within 50
+	static const float LedgeAbovePelvis = 25.0f;
+
+	/** Worst frame seen per scenario */
+	struct FScenarioWorst
+	{
+		FScenarioWorst()
+		{
+			for (int32& Queries : MaxQueries)
+			{
+				Queries = INDEX_NONE;
+			}
+		}
+
+		void Record(const UClimbingComponent* Climbing)
+		{
+			int32& Queries = MaxQueries[(int32)Climbing->GetLastFrameScenario()];
+			Queries = FMath::Max(Queries, Climbing->GetLastFrameSceneQueries());
+		}
+
+		int32 MaxQueries[(int32)EClimbScenario::Count];
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbProbeBudgetTest, "Movement.Climbing.ProbeBudgets",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FClimbProbeBudgetTest::RunTest(const FString& Parameters)
+{
+	using namespace ClimbProbeBudgetTest;
+
+	UClass* CharacterClass = LoadClass<AMovementCharacter>(nullptr, CharacterClassPath);
+	if (!TestNotNull(TEXT("Player character blueprint loads"), CharacterClass))
+	{
+		return false;
+	}
+
+	FClimbingTestLevel TestLevel;
+	TestLevel.AddFloor(0.0f);
+
+	// Uncontrolled and not walking, so the character only moves where a scenario puts it
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AMovementCharacter* Character = TestLevel.GetWorld()->SpawnActor<AMovementCharacter>(CharacterClass, IdleLocation, FRotator::ZeroRotator, SpawnParams);
+	Character->GetCharacterMovement()->SetMovementMode(MOVE_Flying);
+	Character->EnableClimbing();
+	UClimbingComponent* Climbing = Character->GetClimbing();
+	TestLevel.Tick();
+
+	// Ledges go where this character's pelvis can grab them
+	const float LedgeTop = Character->GetMesh()->GetSocketLocation(TEXT("PelvisSocket")).Z - IdleLocation.Z + LedgeLocation.Z + LedgeAbovePelvis;
+	const float WallX = LedgeLocation.X + WallDistance;
+
+	// A wall too tall to grab to walk along
+	TestLevel.AddBlock(FVector(WallX + 100.0f, WallLocation.Y + 500.0f, LedgeTop + 500.0f), FVector(100.0f, 500.0f, (LedgeTop + 500.0f) / 2.0f));
+
+	// A ledge ending just right of the character and another past a gap to hop to
+	TestLevel.AddBlock(FVector(WallX + 100.0f, -140.0f, LedgeTop), FVector(100.0f, 160.0f, LedgeTop / 2.0f));
+	TestLevel.AddBlock(FVector(WallX + 100.0f, 255.0f, LedgeTop), FVector(100.0f, 145.0f, LedgeTop / 2.0f));
+
+	FScenarioWorst Worst;
+	auto TickScenario = [&](int32 NumFrames)
+	{
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			TestLevel.Tick();
+			Worst.Record(Climbing);
+		}
+	};
+	auto GrabLedge = [&]()
+	{
+		Character->GetCharacterMovement()->SetMovementMode(MOVE_Flying);
+		Character->SetActorLocationAndRotation(LedgeLocation, FRotator::ZeroRotator);
+		for (int32 Frame = 0; Frame < 10 && !Climbing->IsHanging(); ++Frame)
+		{
+			TickScenario(1);
+		}
+		return Climbing->IsHanging();
+	};
+
+	TickScenario(30);
+
+	for (int32 Frame = 0; Frame < 60; ++Frame)
+	{
+		Character->SetActorLocation(WallLocation + FVector(0.0f, Frame * 10.0f, 0.0f));
+		TickScenario(1);
+	}
+
+	if (!TestTrue(TEXT("Grabbed the ledge"), GrabLedge()))
+	{
+		return false;
+	}
+
+	// Long enough for the capsule to settle and the hop search to go round its candidates twice
+	TickScenario(30);
+	TestTrue(TEXT("Hop target found across the gap"), Climbing->bCanLedgeJumpRight && Climbing->bHasHopTarget);
+
+	for (int32 Frame = 0; Frame < 30; ++Frame)
+	{
+		Climbing->HandleMoveRight(-1.0f);
+		TickScenario(1);
+	}
+	Climbing->HandleMoveRight(0.0f);
+	TickScenario(10);
+
+	// The anim blueprint ends the climb up with a notify, which is called directly here
+	Climbing->HandleJump();
+	TickScenario(30);
+	Climbing->ClimbLedgeEventOver();
+	TickScenario(1);
+
+	if (TestTrue(TEXT("Grabbed the ledge again"), GrabLedge()))
+	{
+		TickScenario(15);
+		Climbing->ExitLedge();
+		TickScenario(1);
+	}
+
+	for (int32 Index = 0; Index < (int32)EClimbScenario::Count; ++Index)
+	{
+		const EClimbScenario Scenario = (EClimbScenario)Index;
+		const TCHAR* Name = FClimbProbeBudget::GetScenarioName(Scenario);
+		const int32 Budget = FClimbProbeBudget::Get().GetBudget(Scenario);
+		const int32 Queries = Worst.MaxQueries[Index];
+		if (TestTrue(FString::Printf(TEXT("%s scenario played"), Name), Queries != INDEX_NONE) &&
+			TestTrue(FString::Printf(TEXT("%s has a budget in [ClimbProbeBudgets]"), Name), Budget != INDEX_NONE))
+		{
+			TestTrue(FString::Printf(TEXT("%s worst frame of %d scene queries is within its budget of %d"), Name, Queries, Budget), Queries <= Budget);
+		}
+	}
+	return true;
+}
+
+#endif
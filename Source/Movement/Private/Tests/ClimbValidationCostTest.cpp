@@ -0,0 +1,136 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbingComponent.h"
+#include "ClimbingTestLevel.h"
+#include "MovementCharacter.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ClimbValidationCostTest
+{
+	// The player character, its anim blueprint implements the ledge climb interface grabbing needs
+	static const TCHAR* CharacterClassPath = TEXT("/Game/ThirdPersonCPP/Blueprints/ThirdPersonCharacter.ThirdPersonCharacter_C");
+
+	// Where the character stands facing +X, the face of the wall in front of it, and how far above it the top is
+	static const FVector CharacterLocation(0.0f, 0.0f, 200.0f);
+	static const float WallX = 100.0f;
+	static const float LedgeAboveCharacter = 60.0f;
+
+	// Units a second HandleMoveRight shimmies at
+	static const float ShimmySpeed = 100.0f;
+
+	// How far the server lets shimmy steps get ahead of shimmy speed, one full step
+	static const float ShimmyBurst = 20.0f;
+
+	static const int32 NumGrabValidations = 1000;
+	static const int32 NumShimmySteps = 60;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbValidationCostTest, "Movement.Climbing.ValidationCost",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FClimbValidationCostTest::RunTest(const FString& Parameters)
+{
+	using namespace ClimbValidationCostTest;
+
+	UClass* CharacterClass = LoadClass<AMovementCharacter>(nullptr, CharacterClassPath);
+	if (!TestNotNull(TEXT("Player character blueprint loads"), CharacterClass))
+	{
+		return false;
+	}
+
+	FClimbingTestLevel TestLevel;
+	TestLevel.AddFloor(0.0f);
+	const float LedgeTop = CharacterLocation.Z + LedgeAboveCharacter;
+	TestLevel.AddBlock(FVector(WallX + 100.0f, 0.0f, LedgeTop), FVector(100.0f, 500.0f, 150.0f));
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AMovementCharacter* Character = TestLevel.GetWorld()->SpawnActor<AMovementCharacter>(CharacterClass, CharacterLocation, FRotator::ZeroRotator, SpawnParams);
+	Character->GetCharacterMovement()->SetMovementMode(MOVE_Flying);
+	Character->EnableClimbing();
+	UClimbingComponent* Climbing = Character->GetClimbing();
+	TestLevel.Tick();
+
+	// An honest grab claim, the way the client's forward and height probes report it
+	const FVector ClaimedHeight(WallX + 28.0f, 0.0f, LedgeTop);
+	const FVector ClaimedWall(WallX, 0.0f, LedgeTop - 20.0f);
+	const FVector ClaimedNormal(-1.0f, 0.0f, 0.0f);
+
+	Climbing->FrameSceneQueries = 0;
+	int32 GrabsAccepted = 0;
+	const double GrabStart = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumGrabValidations; ++Index)
+	{
+		FVector HeightLocation = ClaimedHeight;
+		FVector WallLocation = ClaimedWall;
+		FVector WallNormal = ClaimedNormal;
+		UPrimitiveComponent* Base = nullptr;
+		if (Climbing->ValidateLedgeGrab(HeightLocation, WallLocation, WallNormal, Base))
+		{
+			++GrabsAccepted;
+		}
+	}
+	const double GrabSeconds = FPlatformTime::Seconds() - GrabStart;
+	const int32 GrabQueries = Climbing->FrameSceneQueries;
+	TestEqual(TEXT("Every honest grab accepted"), GrabsAccepted, NumGrabValidations);
+
+	Climbing->ServerHandleGrab(ClaimedHeight, ClaimedWall, ClaimedNormal);
+	TestLevel.Tick(30);
+	if (!TestTrue(TEXT("Hanging after the validated grab"), Climbing->IsHanging()))
+	{
+		return false;
+	}
+
+	// Honest steps, one per frame at shimmy speed, each validated on its own so the tick is not timed
+	const FVector RightAxis = Character->GetActorRightVector();
+	const float StepLength = ShimmySpeed * FClimbingTestLevel::FrameTime;
+	double ShimmySeconds = 0.0;
+	int32 ShimmyQueries = 0;
+	int32 StepsAccepted = 0;
+	for (int32 Step = 0; Step < NumShimmySteps; ++Step)
+	{
+		TestLevel.Tick();
+		const FVector NewLocation = Character->GetActorLocation() + RightAxis * StepLength;
+		float PaidUntil = 0.0f;
+		Climbing->FrameSceneQueries = 0;
+		const double StepStart = FPlatformTime::Seconds();
+		const bool bValid = Climbing->ValidateLedgeShimmy(NewLocation, true, PaidUntil);
+		ShimmySeconds += FPlatformTime::Seconds() - StepStart;
+		ShimmyQueries += Climbing->FrameSceneQueries;
+		if (bValid)
+		{
+			++StepsAccepted;
+			Climbing->ServerHandleShimmy(NewLocation, true);
+		}
+	}
+	TestEqual(TEXT("Every step at shimmy speed accepted"), StepsAccepted, NumShimmySteps);
+
+	// Steps twice as long every frame only get as far as shimmying would, plus the one step that may be saved up
+	const FVector HackStart = Character->GetActorLocation();
+	for (int32 Step = 0; Step < NumShimmySteps; ++Step)
+	{
+		TestLevel.Tick();
+		Climbing->ServerHandleShimmy(Character->GetActorLocation() + RightAxis * 2.0f * StepLength, true);
+	}
+	const float HackDistance = FVector::DotProduct(Character->GetActorLocation() - HackStart, RightAxis);
+	TestTrue(FString::Printf(TEXT("Double speed steps held to shimmy speed (%.1f units)"), HackDistance),
+		HackDistance <= NumShimmySteps * StepLength + ShimmyBurst + 1.0f);
+
+	// Steps have to run along the ledge
+	TestLevel.Tick();
+	const FVector OffAxisStart = Character->GetActorLocation();
+	Climbing->ServerHandleShimmy(OffAxisStart + RightAxis * StepLength + FVector(0.0f, 0.0f, 10.0f), true);
+	TestTrue(TEXT("Step off the ledge line rejected"), Character->GetActorLocation().Equals(OffAxisStart));
+
+	AddInfo(FString::Printf(TEXT("Grab validation %.2f us and %.1f scene queries, shimmy validation %.2f us and %.1f scene queries"),
+		GrabSeconds * 1000000.0 / NumGrabValidations, (float)GrabQueries / NumGrabValidations,
+		ShimmySeconds * 1000000.0 / NumShimmySteps, (float)ShimmyQueries / NumShimmySteps));
+	return true;
+}
+
+#endif
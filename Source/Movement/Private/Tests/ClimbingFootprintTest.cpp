@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MovementCharacter.h"
+#include "ClimbingComponent.h"
+#include "ClimbingTestLevel.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ClimbingFootprintTest
+{
+	static const int32 NumCharacters = 1000;
+	static const int32 NumTickFrames = 120;
+
+	struct FResult
+	{
+		int64 UsedPhysicalBytes;
+		double TickMilliseconds;
+		int32 Climbers;
+	};
+
+	/** Spawns NumCharacters idle characters in open space and measures what they cost */
+	static FResult Measure(bool bClimbing)
+	{
+		FClimbingTestLevel TestLevel;
+		TestLevel.AddFloor(0.0f);
+		TestLevel.Tick();
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		FResult Result;
+		Result.Climbers = 0;
+		const uint64 UsedPhysicalBefore = FPlatformMemory::GetStats().UsedPhysical;
+		const int32 PerRow = FMath::CeilToInt(FMath::Sqrt((float)NumCharacters));
+		for (int32 Index = 0; Index < NumCharacters; ++Index)
+		{
+			const FVector Location((Index % PerRow) * 200.0f, (Index / PerRow) * 200.0f, 100.0f);
+			AMovementCharacter* Character = TestLevel.GetWorld()->SpawnActor<AMovementCharacter>(Location, FRotator::ZeroRotator, SpawnParams);
+			if (bClimbing)
+			{
+				Character->EnableClimbing();
+			}
+			Result.Climbers += Character->GetClimbing() ? 1 : 0;
+		}
+		Result.UsedPhysicalBytes = (int64)FPlatformMemory::GetStats().UsedPhysical - (int64)UsedPhysicalBefore;
+
+		// The first frames register tick functions and settle the characters on the floor
+		TestLevel.Tick(10);
+		const double StartTime = FPlatformTime::Seconds();
+		TestLevel.Tick(NumTickFrames);
+		Result.TickMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0 / NumTickFrames;
+		return Result;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbingFootprintTest, "Movement.Climbing.Footprint",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FClimbingFootprintTest::RunTest(const FString& Parameters)
+{
+	using namespace ClimbingFootprintTest;
+
+	const FResult Plain = Measure(false);
+	const FResult Climbing = Measure(true);
+	TestEqual(TEXT("Characters nobody controls do not climb by default"), Plain.Climbers, 0);
+	TestEqual(TEXT("Every climber got a component"), Climbing.Climbers, NumCharacters);
+
+	// Process wide physical memory, so run this on its own for stable numbers
+	AddInfo(FString::Printf(TEXT("%d characters without climbing: %lld bytes resident (%lld each), %.3f ms per frame"),
+		NumCharacters, Plain.UsedPhysicalBytes, Plain.UsedPhysicalBytes / NumCharacters, Plain.TickMilliseconds));
+	AddInfo(FString::Printf(TEXT("%d characters with climbing: %lld bytes resident (%lld each), %.3f ms per frame"),
+		NumCharacters, Climbing.UsedPhysicalBytes, Climbing.UsedPhysicalBytes / NumCharacters, Climbing.TickMilliseconds));
+	AddInfo(FString::Printf(TEXT("Climbing costs %lld bytes and %.3f us of frame time per character"),
+		(Climbing.UsedPhysicalBytes - Plain.UsedPhysicalBytes) / NumCharacters,
+		(Climbing.TickMilliseconds - Plain.TickMilliseconds) * 1000.0 / NumCharacters));
+	return true;
+}
+
+#endif
@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ClimbingTestLevel.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Components/BoxComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+
+const float FClimbingTestLevel::FrameTime = 1.0f / 60.0f;
+
+FClimbingTestLevel::FClimbingTestLevel()
+{
+	World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("ClimbingTestLevel"));
+	GEngine->CreateNewWorldContext(EWorldType::Game).SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+
+	// There is no game mode to start play, actors spawned from here on begin play straight away
+	World->GetWorldSettings()->NotifyBeginPlay();
+}
+
+FClimbingTestLevel::~FClimbingTestLevel()
+{
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	World->RemoveFromRoot();
+}
+
+AActor* FClimbingTestLevel::AddBlock(const FVector& TopCenter, const FVector& HalfExtent, bool bClimbable, bool bMovable)
+{
+	AActor* Actor = World->SpawnActor<AActor>();
+
+	UBoxComponent* Box = NewObject<UBoxComponent>(Actor, TEXT("Block"));
+	Box->SetMobility(bMovable ? EComponentMobility::Movable : EComponentMobility::Static);
+	Box->SetBoxExtent(HalfExtent, false);
+	Box->SetRelativeLocation(TopCenter - FVector(0.0f, 0.0f, HalfExtent.Z));
+	Box->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+	Box->SetCollisionResponseToChannel(ECC_GameTraceChannel1, bClimbable ? ECR_Block : ECR_Ignore);
+	Actor->SetRootComponent(Box);
+	Box->RegisterComponent();
+	return Actor;
+}
+
+AActor* FClimbingTestLevel::AddFloor(float Height)
+{
+	return AddBlock(FVector(0.0f, 0.0f, Height), FVector(10000.0f, 10000.0f, 10.0f), false);
+}
+
+void FClimbingTestLevel::Tick(int32 NumFrames)
+{
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		World->Tick(LEVELTICK_All, FrameTime);
+	}
+}
+
+#endif
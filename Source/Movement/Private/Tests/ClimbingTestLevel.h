@@ -0,0 +1,40 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+class AActor;
+class UWorld;
+
+/**
+ * Throwaway game world for the climbing automation tests. Levels are built from boxes in code, so
+ * the tests do not depend on any map, and the world is ticked by hand at a fixed step so scene
+ * query counts are repeatable.
+ */
+class FClimbingTestLevel
+{
+public:
+	/** Fixed step every Tick advances the world by */
+	static const float FrameTime;
+
+	FClimbingTestLevel();
+	~FClimbingTestLevel();
+
+	UWorld* GetWorld() const { return World; }
+
+	/** Box with the centre of its top face at TopCenter, blocking the ledge trace channel when bClimbable */
+	AActor* AddBlock(const FVector& TopCenter, const FVector& HalfExtent, bool bClimbable = true, bool bMovable = false);
+
+	/** Large floor with its top at Height that does not block the ledge trace channel */
+	AActor* AddFloor(float Height);
+
+	void Tick(int32 NumFrames = 1);
+
+private:
+	UWorld* World;
+};
+
+#endif
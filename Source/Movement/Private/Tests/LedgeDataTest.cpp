@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "LedgeData.h"
+#include "ClimbingTestLevel.h"
+#include "Engine/Level.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLedgeDataStreamingTest, "Movement.Climbing.LedgeData.Streaming",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLedgeDataStreamingTest::RunTest(const FString& Parameters)
+{
+	static const int32 BlocksPerSide = 8;
+	static const float BlockSpacing = 400.0f;
+
+	FClimbingTestLevel TestLevel;
+	UWorld* World = TestLevel.GetWorld();
+	ULevel* Level = World->PersistentLevel;
+	TestLevel.AddFloor(0.0f);
+	for (int32 Y = 0; Y < BlocksPerSide; ++Y)
+	{
+		for (int32 X = 0; X < BlocksPerSide; ++X)
+		{
+			TestLevel.AddBlock(FVector(X * BlockSpacing, Y * BlockSpacing, 300.0f), FVector(100.0f, 100.0f, 150.0f));
+		}
+	}
+
+	// Bake the way Climbing.BakeLedgeData does
+	TArray<FLedgeSegment> Segments;
+	TArray<FBox> UnbakedBounds;
+	FLedgeDataBuilder::GatherSegments(Level, Segments, UnbakedBounds);
+	TestEqual(TEXT("Every block has four top edges and the floor none"), Segments.Num(), BlocksPerSide * BlocksPerSide * 4);
+	TestEqual(TEXT("Every climbable primitive is a static box"), UnbakedBounds.Num(), 0);
+
+	TArray<uint8> Data;
+	FLedgeDataBuilder::Serialize(Segments, UnbakedBounds, 1000.0f, Data);
+	TArray<uint8> FieldData;
+	FClimbFieldBuilder::Bake(Level, Segments, 25.0f, 175.0f, FieldData);
+
+	// Keep the test's files out of the project, and gone however the test ends
+	FLedgeDataRegistry& Registry = FLedgeDataRegistry::Get();
+	FLedgeDataBuilder::SetDataDirectoryOverride(FPaths::AutomationTransientDir() / TEXT("LedgeData"));
+	const FString Filename = FLedgeDataBuilder::GetLedgeDataFilename(Level);
+	const FString FieldFilename = FClimbFieldBuilder::GetClimbFieldFilename(Level);
+	ON_SCOPE_EXIT
+	{
+		Registry.UnregisterLevel(Level);
+		FLedgeDataBuilder::SetDataDirectoryOverride(FString());
+		IFileManager::Get().Delete(*Filename);
+		IFileManager::Get().Delete(*FieldFilename);
+	};
+
+	if (!TestTrue(TEXT("Ledge data written"), FFileHelper::SaveArrayToFile(Data, *Filename)) ||
+		!TestTrue(TEXT("Climb field written"), FFileHelper::SaveArrayToFile(FieldData, *FieldFilename)))
+	{
+		return false;
+	}
+
+	// Stream the level in, mapping by itself should not make the files resident
+	Registry.UnregisterLevel(Level);
+	const uint64 UsedPhysicalBefore = FPlatformMemory::GetStats().UsedPhysical;
+	FWorldDelegates::LevelAddedToWorld.Broadcast(Level, World);
+	const uint64 UsedPhysicalMapped = FPlatformMemory::GetStats().UsedPhysical;
+
+	double LoadSeconds = 0.0;
+	int64 MappedBytes = 0;
+	if (TestTrue(TEXT("Level registered when streamed in"), Registry.GetLevelStats(Level, LoadSeconds, MappedBytes)))
+	{
+		TestEqual(TEXT("Both files mapped"), MappedBytes, (int64)Data.Num() + FieldData.Num());
+		TestTrue(TEXT("Ledge data covers the world"), Registry.CoversWorld(World));
+		TestTrue(TEXT("Climb field covers the world"), Registry.FieldCoversWorld(World));
+
+		FLedgeSegment Segment;
+		FVector ClosestPoint;
+		TestTrue(TEXT("Baked ledge found"), Registry.FindNearestSegment(World, FVector(0.0f, -120.0f, 300.0f), 50.0f, Segment, ClosestPoint));
+		// Block (0, 0) spans -100..100 in Y, so its face is 50 in front of the sample
+		FClimbSurfaceSample Sample;
+		if (TestTrue(TEXT("Climb field sampled next to a wall"), Registry.SampleClimbField(World, FVector(0.0f, -150.0f, 250.0f), Sample)))
+		{
+			TestTrue(FString::Printf(TEXT("Distance to the face (%.2f)"), Sample.Distance), FMath::IsNearlyEqual(Sample.Distance, 50.0f, 2.0f));
+			TestTrue(FString::Printf(TEXT("Normal of the face (%s)"), *Sample.Normal.ToString()), Sample.Normal.Equals(FVector(0.0f, -1.0f, 0.0f), 0.05f));
+		}
+		const uint64 UsedPhysicalQueried = FPlatformMemory::GetStats().UsedPhysical;
+
+		// Physical memory is process wide, so the deltas are indicative rather than exact
+		AddInfo(FString::Printf(TEXT("%d segments, load %.3f ms, %lld bytes mapped, %lld bytes resident after mapping, %lld after queries"),
+			Segments.Num(), LoadSeconds * 1000.0, MappedBytes,
+			(int64)UsedPhysicalMapped - (int64)UsedPhysicalBefore, (int64)UsedPhysicalQueried - (int64)UsedPhysicalBefore));
+	}
+
+	FWorldDelegates::LevelRemovedFromWorld.Broadcast(Level, World);
+	TestFalse(TEXT("Level unregistered when streamed out"), Registry.GetLevelStats(Level, LoadSeconds, MappedBytes));
+	TestFalse(TEXT("Streamed out level no longer covered"), Registry.CoversWorld(World));
+	return true;
+}
+
+#endif
@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ULevel;
+struct FLedgeSegment;
+
+/**
+ * Baked distance to climbable geometry, stored per level in Content/LedgeData/<LevelName>.climbfield
+ * next to the ledge data and mapped the same way. Following a wall costs a few memory reads per
+ * frame instead of sweeps.
+ *
+ * Space is cut into bricks of Size^3 samples. Neighbouring bricks share their border samples, so a
+ * trilinear lookup reads all 8 of its samples from one 4KB brick. Bricks further than the baked
+ * band from every climbable primitive are not stored, and stored ones are found through an open
+ * addressed hash of their cell, so the index grows with the stored bricks rather than the level's
+ * volume.
+ *
+ * Layout: FClimbFieldHeader, HashSize FClimbFieldSlot, padding to 4KB, NumBricks FClimbFieldBrick.
+ */
+struct FClimbFieldHeader
+{
+	static const uint32 ExpectedMagic = 0x43534446; // 'CSDF'
+	static const uint32 ExpectedVersion = 2;
+	static const uint32 EmptyBrick = 0xFFFFFFFF;
+
+	uint32 Magic;
+	uint32 Version;
+	FVector Origin;
+	/** Distance between neighbouring samples */
+	float VoxelSize;
+	int32 BricksX;
+	int32 BricksY;
+	int32 BricksZ;
+	uint32 NumBricks;
+	/** Slots in the brick hash, a power of two at least twice NumBricks */
+	uint32 HashSize;
+	uint32 Pad;
+};
+
+/** Brick hash entry, slots are probed linearly from the cell's hash until a match or an empty slot */
+struct FClimbFieldSlot
+{
+	/** (BrickZ * BricksY + BrickY) * BricksX + BrickX */
+	uint64 Cell;
+	/** Index into the bricks, EmptyBrick for an unused slot */
+	uint32 Brick;
+	uint32 Pad;
+};
+
+/** One baked sample, lengths are stored in sixteenths of a unit */
+struct FClimbFieldVoxel
+{
+	static const int16 NoLedge = MIN_int16;
+	static const int32 UnitScale = 16;
+
+	/** Unsigned distance to the nearest climbable surface, 0 inside geometry */
+	int16 Distance;
+	/** Height of the nearest ledge edge above the sample, NoLedge when none is within the band */
+	int16 LedgeHeight;
+	/** Direction from the nearest surface point to the sample, scaled to +-127 */
+	int8 Normal[3];
+	uint8 Pad;
+};
+
+struct FClimbFieldBrick
+{
+	static const int32 Size = 8;
+
+	/** X fastest, then Y, then Z */
+	FClimbFieldVoxel Voxels[Size * Size * Size];
+};
+
+static_assert(sizeof(FClimbFieldHeader) == 48, "FClimbFieldHeader is an on-disk layout");
+static_assert(sizeof(FClimbFieldSlot) == 16, "FClimbFieldSlot is an on-disk layout");
+static_assert(sizeof(FClimbFieldVoxel) == 8, "FClimbFieldVoxel is an on-disk layout");
+static_assert(sizeof(FClimbFieldBrick) == 4096, "FClimbFieldBrick is an on-disk layout");
+
+/** Field value at a point, interpolated from the surrounding samples */
+struct FClimbSurfaceSample
+{
+	/** Distance to the nearest climbable surface */
+	float Distance;
+	/** Points away from that surface, so the surface point is Location - Normal * Distance */
+	FVector Normal;
+	bool bHasLedge;
+	/** Height of the nearest ledge edge above the sampled location, valid when bHasLedge is set */
+	float LedgeHeight;
+};
+
+/** Read-only view over a climb field blob, does not own the memory */
+class MOVEMENT_API FClimbFieldView
+{
+public:
+	FClimbFieldView();
+
+	/** Validates the header and sizes, slots are checked as lookups reach them so mapping touches no index pages */
+	bool Initialize(const uint8* Data, int64 Size);
+
+	bool IsValid() const { return Header != nullptr; }
+
+	int32 NumBricks() const { return Header ? Header->NumBricks : 0; }
+
+	/** Trilinear lookup, returns false where nothing climbable is within the baked band */
+	bool Sample(const FVector& Location, FClimbSurfaceSample& OutSample) const;
+
+private:
+	/** Stored brick of a cell, or nullptr */
+	const FClimbFieldBrick* FindBrick(uint64 Cell) const;
+
+	const FClimbFieldHeader* Header;
+	const FClimbFieldSlot* Slots;
+	const FClimbFieldBrick* Bricks;
+};
+
+/** Bakes and writes climb field files */
+struct MOVEMENT_API FClimbFieldBuilder
+{
+	/**
+	 * Samples the distance to every static primitive in Level that blocks the ledge trace channel, movable ones are left to physics.
+	 * @param Ledges	Ledge segments of the level, the nearest one within Band is stored per sample
+	 * @param Band		Bricks further than this from every climbable primitive are left out
+	 */
+	static void Bake(const ULevel* Level, const TArray<FLedgeSegment>& Ledges, float VoxelSize, float Band, TArray<uint8>& OutData);
+
+	static FString GetClimbFieldFilename(const ULevel* Level);
+};
@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** What a climber was doing during a frame, each has its own scene query budget */
+enum class EClimbScenario : uint8
+{
+	/** Nothing climbable in reach, only the reach probe runs */
+	Idle,
+	/** Walking along a wall, forward and height probes run but find nothing to grab */
+	AlongWall,
+	/** The frame a ledge was grabbed */
+	Grab,
+	/** Hanging still, side probes and the hop search run */
+	Hanging,
+	Shimmy,
+	ClimbUp,
+	/** The frame after letting go of a ledge */
+	Exit,
+	Count
+};
+
+/**
+ * Counts the physics scene queries each climber issues per frame and checks them against the
+ * budgets in the [ClimbProbeBudgets] section of DefaultGame.ini. Query counts only depend on
+ * the geometry and the climb state, so unlike timings they are exact and repeatable, and a
+ * change that adds probes to a hot path shows up as an over budget scenario straight away.
+ * The Movement.Climbing.ProbeBudgets automation test plays every scenario and fails when one
+ * goes over; while playing, checking is off unless climbing.ProbeBudget is set.
+ */
+class MOVEMENT_API FClimbProbeBudget
+{
+public:
+	static FClimbProbeBudget& Get();
+
+	FClimbProbeBudget();
+
+	bool IsEnabled() const;
+
+	/** Adds one climber's frame to its scenario, warning the first time a new worst frame goes over budget */
+	void RecordFrame(EClimbScenario Scenario, int32 SceneQueries);
+
+	/** Logs frames, queries and the worst frame of each scenario against its budget, returns false if any went over */
+	bool LogReport() const;
+
+	void Reset();
+
+	/** Rereads the budgets from the game ini, scenarios without an entry are not checked */
+	void LoadBudgets();
+
+	/** Most scene queries allowed in one frame of Scenario, INDEX_NONE when it has no budget */
+	int32 GetBudget(EClimbScenario Scenario) const { return Scenarios[(int32)Scenario].Budget; }
+
+	static const TCHAR* GetScenarioName(EClimbScenario Scenario);
+
+private:
+	struct FScenarioStats
+	{
+		/** Most scene queries allowed in one frame, INDEX_NONE when unchecked */
+		int32 Budget;
+		uint32 Frames;
+		uint64 SceneQueries;
+		int32 MaxFrameQueries;
+	};
+
+	FScenarioStats Scenarios[(int32)EClimbScenario::Count];
+};
@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EClimbAction : uint8
+{
+	Grab,
+	ClimbUp,
+	Shimmy,
+	Exit,
+	Count
+};
+
+enum class EClimbStage : uint8
+{
+	/** Input pressed, or the probe that triggered a grab */
+	Input,
+	/** Hanging/climbing flags and movement mode changed */
+	StateChange,
+	/** The anim instance was told through ILedgeClimbInterface */
+	AnimInterface,
+	/** Capsule reached its MoveComponentTo target or the climb animation ended, or a frame has shown a shimmy step or exit */
+	Complete,
+	Count
+};
+
+struct FClimbTraceEvent
+{
+	/** Slot index + 1 once the event is fully written, so readers can skip torn slots */
+	volatile int32 Sequence;
+	uint32 ActionId;
+	EClimbAction Action;
+	EClimbStage Stage;
+	uint64 Frame;
+	uint64 Cycles;
+};
+
+/**
+ * Timestamps every stage of every climb action into a fixed ring buffer. Writers claim slots
+ * with an atomic increment and never block; old events are overwritten once the buffer wraps.
+ * Recording is off unless climbing.Trace is set.
+ */
+class MOVEMENT_API FClimbTrace
+{
+public:
+	static const int32 Capacity = 4096;
+
+	static FClimbTrace& Get();
+
+	FClimbTrace();
+
+	bool IsEnabled() const;
+
+	/** Records the Input stage of a new action, returns its id or 0 when tracing is off */
+	uint32 BeginAction(EClimbAction Action);
+
+	/** Records Stage for an action started by BeginAction, ignores id 0 */
+	void MarkStage(uint32 ActionId, EClimbAction Action, EClimbStage Stage);
+
+	void Reset();
+
+	/** Writes the buffered events in Chrome trace event format, viewable in chrome://tracing */
+	bool ExportChromeTrace(const FString& Filename) const;
+
+	/** Logs a histogram of Input to last stage latency per action */
+	void LogHistograms() const;
+
+	static const TCHAR* GetActionName(EClimbAction Action);
+	static const TCHAR* GetStageName(EClimbStage Stage);
+
+private:
+	void Record(uint32 ActionId, EClimbAction Action, EClimbStage Stage);
+
+	/** Copies the complete events still in the buffer, oldest first */
+	void Snapshot(TArray<FClimbTraceEvent>& OutEvents) const;
+
+	FClimbTraceEvent Events[Capacity];
+	volatile int32 WriteIndex;
+	volatile int32 NextActionId;
+};
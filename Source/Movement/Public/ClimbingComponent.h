@@ -0,0 +1,249 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "LedgeHopSearch.h"
+#include "ClimbTrace.h"
+#include "ClimbProbeBudget.h"
+#include "ClimbingComponent.generated.h"
+
+class AMovementCharacter;
+class UPrimitiveComponent;
+
+/** Ledge found by one pair of forward and height probes, kept relative to the wall it was found on */
+struct FClimbLedgeProbe
+{
+	/** Primitive the forward probes hit, the locations below are in its space, or world space without one */
+	TWeakObjectPtr<UPrimitiveComponent> Base;
+	FVector HeightLocation;
+	FVector WallLocation;
+	FVector WallNormal;
+
+	void SetWall(UPrimitiveComponent* InBase, const FVector& InWallLocation, const FVector& InWallNormal);
+	void SetHeight(const FVector& InHeightLocation);
+
+	/** World space, wherever the base has moved since the probe */
+	FVector GetHeightLocation() const;
+	FVector GetWallLocation() const;
+	FVector GetWallNormal() const;
+
+private:
+	FTransform GetBaseTransform() const;
+};
+
+/** The ledge being hung from, kept relative to the primitive it belongs to so moving it does not invalidate it */
+struct FClimbBasedLedge
+{
+	TWeakObjectPtr<UPrimitiveComponent> Base;
+	/** Where the capsule hangs, in Base space, the move target until the grab move finishes and then where it ended up */
+	FVector HangLocation;
+	FQuat HangRotation;
+	/** Collision signature of Base when the ledge was probed */
+	uint32 CollisionSignature;
+	/** Time left of the grab move, retargeted from Base every tick while it runs on a movable base */
+	float MoveTimeLeft;
+	/** Set once the grab move finished and HangLocation is where the capsule actually is */
+	uint8 bSettled : 1;
+};
+
+/** Last probe results for both sides of the character, and the ledge they led to */
+struct FClimbLedgeCache
+{
+	FClimbLedgeProbe Right;
+	FClimbLedgeProbe Left;
+	FClimbBasedLedge Hanging;
+};
+
+/**
+ * Ledge grabbing, shimmying, hopping and climbing for an AMovementCharacter. Characters only get
+ * one when a player controls them or they are set to climb, so everyone else pays neither its
+ * memory nor its per-frame probes.
+ */
+UCLASS(ClassGroup = (Movement), Blueprintable)
+class MOVEMENT_API UClimbingComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UClimbingComponent();
+
+	virtual void OnRegister() override;
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** Input forwarded by the owning character, the bool ones return true if climbing consumed it */
+	bool HandleJump();
+	bool HandleMoveRight(float Value);
+	void HandleMoveForward(float Value);
+	void ExitLedge();
+
+	/** Called by the anim blueprint through the character once the climb up animation ends */
+	void ClimbLedgeEventOver();
+
+	/** Server side of the character's climbing RPCs */
+	void ServerHandleGrab(const FVector& HeightLocation, const FVector& WallLocation, const FVector& WallNormal);
+	void ServerHandleShimmy(const FVector& NewLocation, bool bRight);
+	void ServerHandleClimb();
+	void ClientHandleCorrection(bool bAccepted, const FVector& HeightLocation, const FVector& WallLocation, const FVector& WallNormal, UPrimitiveComponent* Base);
+
+	/** Plays the hang, climb and shimmy state the server replicated on a character this machine does not probe for */
+	void ApplyReplicatedClimbState(bool bHanging, bool bLedgeClimbing, bool bMovingRight, bool bMovingLeft);
+
+	/** Scene queries the last tick counted and the scenario they counted against */
+	int32 GetLastFrameSceneQueries() const { return LastFrameSceneQueries; }
+	EClimbScenario GetLastFrameScenario() const { return LastFrameScenario; }
+
+	bool IsHanging() const { return bIsHanging; }
+	bool IsLedgeClimbing() const { return bIsLedgeClimbing; }
+
+	float ClimbArrowRadius;
+
+	/** Sideways distance from the centre line to the middle of each side's probe pair, half the native capsule radius the arrows were laid out with */
+	float ClimbProbeSpacing;
+
+	/** How far in front of the character the forward probes reach */
+	float LedgeReachDistance;
+
+	/** Height above the forward hit point at which the height probes start */
+	float LedgeHeightProbeOffset;
+
+	/** How far a client's claimed ledge or shimmy position may be from what the server finds */
+	float ClimbValidationTolerance;
+
+	/** Hop candidates probed per frame while hanging, the rest keep their last result, set on the class the character's ClimbingComponentClass names */
+	UPROPERTY(EditDefaultsOnly, Category = "LedgeClimbing")
+	int32 HopCandidatesPerFrame;
+
+	/** Ledge the character would hop to right now, valid when bHasHopTarget is set, refreshed from the candidate's base every frame */
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "LedgeClimbing")
+	FVector HopTargetLocation;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "LedgeClimbing")
+	uint8 bCanLedgeMoveRight : 1;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "LedgeClimbing")
+	uint8 bCanLedgeMoveLeft : 1;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "LedgeClimbing")
+	uint8 bMovingLedgeRight : 1;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "LedgeClimbing")
+	uint8 bMovingLedgeLeft : 1;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "LedgeClimbing")
+	uint8 bCanLedgeJumpLeft : 1;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "LedgeClimbing")
+	uint8 bCanLedgeJumpRight : 1;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "LedgeClimbing")
+	uint8 bHasHopTarget : 1;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "LedgeClimbing")
+	uint8 bIsHanging : 1;
+
+	UPROPERTY(VisibleInstanceOnly, BlueprintReadOnly, Category = "LedgeClimbing")
+	uint8 bIsLedgeClimbing : 1;
+
+protected:
+	/** Probes run where input is, remote clients' characters are validated instead of re-probed on the server */
+	bool ShouldRunLedgeProbes() const;
+
+	/** Single broad query for climbable geometry in the reach volume, gates the detailed probes and decides whether they may use baked data */
+	bool ReachTracer();
+
+	/** Forward and height probes for one side, Side is 1 for right and -1 for left */
+	bool ForwardTracer(float Side, FClimbLedgeProbe& Probe);
+	void HeightTracer(float Side, FClimbLedgeProbe& Probe);
+
+	/** Sphere sweep on the ledge channel, every climbing sweep goes through here so it is counted */
+	bool LedgeSphereTrace(const FVector& Start, const FVector& End, bool bIgnoreOwner, bool bDrawDebug, FHitResult& Hit) const;
+
+	/** Whether the ledge continues to the given side, Side is 1 for right and -1 for left */
+	bool SideTracer(float Side) const;
+
+	/** World location of a forward probe, Spread is -1 for the inner and 1 for the outer one */
+	FVector GetClimbProbeLocation(float Side, float Spread) const;
+
+	/** Hangs from the ledge, following Base with based movement when it is movable */
+	void GrabLedge(FVector HeightLocation, FVector WallLocation, FVector WallNormal, UPrimitiveComponent* Base);
+
+	/** True while the capsule hangs where the last grab put it on an unchanged base, so probing again would find the same ledge */
+	bool IsHangingLedgeCurrent() const;
+
+	/** Keeps a running grab move on a movable base heading for where the ledge is now */
+	void UpdateGrabMove(float DeltaTime);
+
+	/** Starts or retargets the grab move, finishing on its original schedule */
+	void MoveToHangLocation(const FVector& TargetLocation, const FRotator& TargetRotation, float OverTime);
+
+	void ClimbLedgeEvent();
+
+	void UpdateHopSearch();
+
+	/** Copies the flags the anim blueprint reads onto the character */
+	void SyncAnimFlags();
+
+	/**
+	 * Checks a claimed grab against baked ledge data, or two sweeps where it has none, replacing the claimed height, wall and normal
+	 * with the server's. OutBase is the swept ledge's primitive, null for baked ledges, which are static.
+	 */
+	bool ValidateLedgeGrab(FVector& HeightLocation, FVector& WallLocation, FVector& WallNormal, UPrimitiveComponent*& OutBase) const;
+
+	/**
+	 * Checks a claimed shimmy step runs along the ledge in the claimed direction, no faster than shimmying moves,
+	 * and still has a ledge under the hands. OutPaidUntil is what ShimmyPaidUntil becomes if the step is taken.
+	 */
+	bool ValidateLedgeShimmy(const FVector& NewLocation, bool bRight, float& OutPaidUntil) const;
+
+	/** Latent callback from the MoveComponentTo started by GrabLedge */
+	UFUNCTION()
+	void GrabLedgeMoveFinished();
+
+	/** Scenario whose probe budget this frame's scene queries count against */
+	EClimbScenario GetFrameScenario(bool bWallInReach) const;
+
+	void BeginClimbTrace(EClimbAction Action);
+	void MarkClimbTrace(EClimbAction Action, EClimbStage Stage);
+
+	/** Marks Complete for an action whose change was applied this frame once a later frame has shown it */
+	void CompleteClimbTraceNextFrame(EClimbAction Action);
+
+	UPROPERTY(Transient)
+	AMovementCharacter* CharacterOwner;
+
+	FClimbLedgeCache Ledge;
+
+	FLedgeHopSearch HopSearch;
+
+	/** Last hanging input, X right and Y up, used to rank hop candidates */
+	FVector2D LedgeInput;
+
+	/** Trace id of the running instance of each climb action, 0 when none or tracing is off */
+	uint32 ClimbTraceIds[(int32)EClimbAction::Count];
+
+	/** Frame an action's change was applied on, its Complete stage is marked on the first tick after it, 0 when none is pending */
+	uint64 ClimbTraceEffectFrames[(int32)EClimbAction::Count];
+
+	/** Scene queries issued since the last tick, mutable so the const probes can count themselves */
+	mutable int32 FrameSceneQueries;
+
+	/** Grab or Exit when that happened since the last tick, Count otherwise */
+	EClimbScenario ActionScenario;
+
+	/** Set by ReachTracer when the reach volume holds geometry the baked data does not describe, so the probes must use physics */
+	uint8 bReachNeedsPhysics : 1;
+
+	/** Server time up to which accepted shimmy steps have used up the shimmy speed */
+	float ShimmyPaidUntil;
+
+	/** Server time of the last accepted shimmy step, a remote character stops shimmying when they stop arriving */
+	float LastShimmyStepTime;
+
+	int32 LastFrameSceneQueries;
+	EClimbScenario LastFrameScenario;
+
+	// Times the server checks on their own, without the probes around them
+	friend class FClimbValidationCostTest;
+};
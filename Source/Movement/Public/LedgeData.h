@@ -0,0 +1,214 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/World.h"
+#include "ClimbField.h"
+
+class ULevel;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Baked ledge data is stored per level in Content/LedgeData/<LevelName>.ledges and used straight
+ * from a memory mapping. Everything in the file is referenced by index, never by pointer, so the
+ * mapping can live at any address.
+ *
+ * Only static, upright boxes are baked. The bounds of every other static primitive blocking the
+ * ledge channel are stored alongside, so queries touching them know to ask physics instead.
+ *
+ * Layout: FLedgeDataHeader, (CellsX * CellsY + 1) uint32 cell starts, NumSegments FLedgeSegment,
+ * NumUnbakedBounds FLedgeDataBounds. Segments are sorted by the XY grid cell of their midpoint.
+ */
+struct FLedgeDataHeader
+{
+	static const uint32 ExpectedMagic = 0x4C444745; // 'LDGE'
+	static const uint32 ExpectedVersion = 2;
+
+	uint32 Magic;
+	uint32 Version;
+	FVector Origin;
+	float CellSize;
+	int32 CellsX;
+	int32 CellsY;
+	/** Longest segment half length, queries are padded by it since segments are binned by midpoint */
+	float MaxHalfLength;
+	uint32 NumSegments;
+	uint32 NumUnbakedBounds;
+};
+
+/** A grabbable top edge with the horizontal normal of the wall below it */
+struct FLedgeSegment
+{
+	FVector Start;
+	FVector End;
+	FVector WallNormal;
+
+	FVector GetClosestPoint(const FVector& Location) const
+	{
+		return FMath::ClosestPointOnSegment(Location, Start, End);
+	}
+};
+
+/** World bounds of a static primitive whose ledges could not be baked */
+struct FLedgeDataBounds
+{
+	FVector Min;
+	FVector Max;
+};
+
+static_assert(sizeof(FLedgeDataHeader) == 44, "FLedgeDataHeader is an on-disk layout");
+static_assert(sizeof(FLedgeSegment) == 36, "FLedgeSegment is an on-disk layout");
+static_assert(sizeof(FLedgeDataBounds) == 24, "FLedgeDataBounds is an on-disk layout");
+
+/** Read-only view over a ledge data blob, does not own the memory */
+class MOVEMENT_API FLedgeDataView
+{
+public:
+	FLedgeDataView();
+
+	/** Validates the blob, returns false and stays invalid if it is malformed */
+	bool Initialize(const uint8* Data, int64 Size);
+
+	bool IsValid() const { return Header != nullptr; }
+
+	int32 Num() const { return Header ? Header->NumSegments : 0; }
+
+	/** True if any ledge segment passes through Box */
+	bool AnySegmentInBox(const FBox& Box) const;
+
+	/** Nearest segment within MaxDistance of Location, or nullptr */
+	const FLedgeSegment* FindNearestSegment(const FVector& Location, float MaxDistance, FVector& OutClosestPoint) const;
+
+	/** True if Box overlaps static geometry that was left to physics */
+	bool AnyUnbakedInBox(const FBox& Box) const;
+
+	/** Calls Visitor(const FLedgeSegment&) for every segment binned in a cell overlapping Box */
+	template<typename VisitorType>
+	void ForEachSegmentNear(const FBox& Box, VisitorType Visitor) const
+	{
+		if (!Header)
+		{
+			return;
+		}
+		const FBox Padded = Box.ExpandBy(Header->MaxHalfLength);
+		const int32 MinX = FMath::Clamp(FMath::FloorToInt((Padded.Min.X - Header->Origin.X) / Header->CellSize), 0, Header->CellsX - 1);
+		const int32 MinY = FMath::Clamp(FMath::FloorToInt((Padded.Min.Y - Header->Origin.Y) / Header->CellSize), 0, Header->CellsY - 1);
+		const int32 MaxX = FMath::Clamp(FMath::FloorToInt((Padded.Max.X - Header->Origin.X) / Header->CellSize), 0, Header->CellsX - 1);
+		const int32 MaxY = FMath::Clamp(FMath::FloorToInt((Padded.Max.Y - Header->Origin.Y) / Header->CellSize), 0, Header->CellsY - 1);
+		for (int32 Y = MinY; Y <= MaxY; ++Y)
+		{
+			for (int32 X = MinX; X <= MaxX; ++X)
+			{
+				const int32 Cell = Y * Header->CellsX + X;
+				for (uint32 Index = CellStarts[Cell]; Index < CellStarts[Cell + 1]; ++Index)
+				{
+					Visitor(Segments[Index]);
+				}
+			}
+		}
+	}
+
+private:
+	const FLedgeDataHeader* Header;
+	const uint32* CellStarts;
+	const FLedgeSegment* Segments;
+	const FLedgeDataBounds* UnbakedBounds;
+};
+
+/** Builds and writes ledge data files */
+struct MOVEMENT_API FLedgeDataBuilder
+{
+	/**
+	 * Collects the top edges of every static, upright box in Level that blocks the ledge trace channel.
+	 * Other static primitives blocking it go to OutUnbakedBounds, movable ones are left out entirely.
+	 */
+	static void GatherSegments(const ULevel* Level, TArray<FLedgeSegment>& OutSegments, TArray<FBox>& OutUnbakedBounds);
+
+	/** Bins Segments into a grid and serializes them and the unbaked bounds into the file layout */
+	static void Serialize(const TArray<FLedgeSegment>& Segments, const TArray<FBox>& UnbakedBounds, float CellSize, TArray<uint8>& OutData);
+
+	static FString GetLedgeDataFilename(const ULevel* Level);
+
+	/** Directory the baked files of every level live in, Content/LedgeData unless overridden */
+	static FString GetDataDirectory();
+
+	/** Redirects baked files elsewhere, an empty string restores the default */
+	static void SetDataDirectoryOverride(const FString& Directory);
+};
+
+/**
+ * Keeps the ledge data and climb field of every loaded level mapped and answers climbing queries
+ * against them. Levels register when they are added to a world (including streamed sublevels) and unregister
+ * when they are removed, so only the loaded area is resident.
+ */
+class MOVEMENT_API FLedgeDataRegistry
+{
+public:
+	static FLedgeDataRegistry& Get();
+
+	void Startup();
+	void Shutdown();
+
+	void RegisterLevel(ULevel* Level);
+	void UnregisterLevel(ULevel* Level);
+	void UnregisterWorld(UWorld* World);
+
+	/**
+	 * True when every visible level of World has ledge data. Movable geometry and static geometry
+	 * that AnyUnbakedInBox reports still need physics queries.
+	 */
+	bool CoversWorld(const UWorld* World) const;
+
+	bool AnySegmentInBox(const UWorld* World, const FBox& Box) const;
+
+	bool AnyUnbakedInBox(const UWorld* World, const FBox& Box) const;
+
+	bool FindNearestSegment(const UWorld* World, const FVector& Location, float MaxDistance, FLedgeSegment& OutSegment, FVector& OutClosestPoint) const;
+
+	/** True when every visible level of World has a climb field */
+	bool FieldCoversWorld(const UWorld* World) const;
+
+	/** Looks Location up in the climb field of the level it falls in, false if nothing climbable is near */
+	bool SampleClimbField(const UWorld* World, const FVector& Location, FClimbSurfaceSample& OutSample) const;
+
+	/** Load time and mapped bytes of a registered level, false if it has no baked data mapped */
+	bool GetLevelStats(const ULevel* Level, double& OutLoadSeconds, int64& OutMappedBytes) const;
+
+	/** Logs load time and mapped bytes for each registered level */
+	void DumpStats() const;
+
+private:
+	struct FEntry
+	{
+		FEntry();
+		~FEntry();
+
+		TWeakObjectPtr<ULevel> Level;
+		FString Filename;
+		IMappedFileHandle* Handle;
+		IMappedFileRegion* Region;
+		FLedgeDataView View;
+		IMappedFileHandle* FieldHandle;
+		IMappedFileRegion* FieldRegion;
+		FClimbFieldView Field;
+		double LoadSeconds;
+		int64 MappedBytes;
+	};
+
+	/** Maps a whole file, returns false and leaves both null if it does not exist */
+	static bool MapFile(const FString& Filename, IMappedFileHandle*& OutHandle, IMappedFileRegion*& OutRegion);
+
+	void OnPostWorldInitialization(UWorld* World, const UWorld::InitializationValues IVS);
+	void OnLevelAdded(ULevel* Level, UWorld* World);
+	void OnLevelRemoved(ULevel* Level, UWorld* World);
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+	TMap<const ULevel*, TUniquePtr<FEntry>> Entries;
+
+	FDelegateHandle PostWorldInitHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	FDelegateHandle WorldCleanupHandle;
+};
@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UPrimitiveComponent;
+
+/** Result of probing one hop offset */
+struct FLedgeHopCandidate
+{
+	/** Where the candidate is probed, relative to the ledge under the hands in the hanging character's space, X into the wall, Y right, Z up */
+	FVector LocalOffset;
+
+	/** From the hands to the ledge actually found, in the same space as LocalOffset, refreshed by every Update */
+	FVector Hop;
+
+	bool bValid;
+
+	/** Primitive the ledge belongs to, LedgeLocation and WallNormal are in its space, or world space without one */
+	TWeakObjectPtr<UPrimitiveComponent> Base;
+
+	/** Top of the ledge found near the offset */
+	FVector LedgeLocation;
+
+	/** Zero when the ledge was found by a sweep, which only sees the top */
+	FVector WallNormal;
+
+	float Score;
+
+	/** World space, wherever the base has moved since the candidate was probed */
+	FVector GetLedgeLocation() const;
+	FVector GetWallNormal() const;
+};
+
+/**
+ * Looks for ledges to hop to while hanging. A fixed set of offsets (sideways, up and diagonal)
+ * is probed round robin, a few per frame, so the cost is flat and every candidate is at most
+ * NumCandidates / Budget frames old when the player hops.
+ */
+class MOVEMENT_API FLedgeHopSearch
+{
+public:
+	static const int32 NumCandidates = 7;
+
+	FLedgeHopSearch();
+
+	/** Forget all results, call when the character grabs a new ledge or lets go */
+	void Reset();
+
+	/**
+	 * Probes up to Budget candidates and rescores all of them.
+	 * @param HandOffset	Edge of the ledge being hung from in the character's space, candidates are placed relative to it
+	 * @param HangBase		Primitive the ledge being hung from belongs to, that ledge is never a hop target
+	 * @param Input			Stick direction, X right and Y up, used to rank candidates by alignment
+	 */
+	void Update(const AActor* Owner, const FVector& HandOffset, const UPrimitiveComponent* HangBase, const FVector2D& Input, float TraceRadius, int32 Budget);
+
+	/** Highest scoring valid candidate, or nullptr */
+	const FLedgeHopCandidate* GetBest() const;
+
+	/** True if a valid candidate lies on the side given by the sign of Direction */
+	bool HasTargetToSide(float Direction) const;
+
+	/** Physics queries the last Update issued, 0 when baked ledge data answered every candidate */
+	int32 GetSceneQueriesLastUpdate() const { return SceneQueriesLastUpdate; }
+
+private:
+	/** Probes one candidate, returns the number of scene queries it issued */
+	int32 Evaluate(const AActor* Owner, const FVector& HandOffset, const UPrimitiveComponent* HangBase, FLedgeHopCandidate& Candidate, float TraceRadius) const;
+
+	FLedgeHopCandidate Candidates[NumCandidates];
+	int32 NextCandidate;
+	int32 BestCandidate;
+	int32 SceneQueriesLastUpdate;
+};